@@ -0,0 +1,546 @@
+// the benchmark searches a fixed set of positions to fixed depths on one thread, and reports the nodes, speed, and chosen moves together with a signature that changes whenever the search behaves differently
+// builds as the CMake target "benchmark", or on Linux with "g++ -std=c++17 -O2 -pthread benchmark.cpp gomoku_engine.cpp -o benchmark"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+// includes the search and evaluation engine, which is shared with the console game
+#include "gomoku_engine.h"
+
+
+/*
+<Summary> :: a benchmark position, which is given by the moves of a game from its first move and searched with the side to move as the AI
+*/
+struct benchmark_position
+{
+    int search_depth;
+    // the moves written as "row,column" counted from 0 at the top left and separated by spaces
+    std::string moves_text;
+};
+
+
+// the built-in positions are taken from AI self-play games, and cover the opening, the middle game, and crowded boards with many threats
+const benchmark_position default_positions[] {
+    {7, "7,7 6,6 7,8 5,7"},
+    {6, "7,7 6,6 7,8 5,7 7,6 7,5 4,8 6,8 7,9 7,10"},
+    {6, "7,7 6,6 7,8 5,7 7,6 7,5 4,8 6,8 7,9 7,10 6,7 5,8 5,6 8,9 4,5 3,4 4,7 4,6 3,5 9,8"},
+    {6, "7,7 6,6 7,8 5,7 7,6 7,5 4,8 6,8 7,9 7,10 6,7 5,8 5,6 8,9 4,5 3,4 4,7 4,6 3,5 9,8 6,11 6,5 8,5 10,7 11,6 8,4 9,3 9,4 6,4 6,9"},
+    {5, "7,7 6,6 7,8 5,7 7,6 7,5 4,8 6,8 7,9 7,10 6,7 5,8 5,6 8,9 4,5 3,4 4,7 4,6 3,5 9,8 6,11 6,5 8,5 10,7 11,6 8,4 9,3 9,4 6,4 6,9 8,11 7,11 5,10 4,9 7,12 8,13 9,10 10,9 10,8 6,13 9,13 5,13 4,13 11,10 12,11"},
+    {7, "7,7 8,8 9,9 8,7 8,6 6,8 9,8"},
+    {6, "7,7 8,8 9,9 8,7 8,6 6,8 9,8 9,7 9,10 7,9 6,10 8,10 9,11 9,12 8,11 7,11"},
+    {6, "7,7 8,8 9,9 8,7 8,6 6,8 9,8 9,7 9,10 7,9 6,10 8,10 9,11 9,12 8,11 7,11 7,12 10,9 10,6 6,13 5,7 9,6 7,8 8,9 9,5 11,7"},
+    {6, "7,7 6,6 7,6 7,5 7,8 5,7 4,8 8,4 9,3 6,8 7,9 7,10"},
+    {6, "7,7 6,6 7,6 7,5 7,8 5,7 4,8 8,4 9,3 6,8 7,9 7,10 6,9 5,9 5,10 8,7 8,9 8,5 4,11 3,12 9,9 10,9 8,8 8,3"},
+    {5, "7,7 6,6 7,6 7,5 7,8 5,7 4,8 8,4 9,3 6,8 7,9 7,10 6,9 5,9 5,10 8,7 8,9 8,5 4,11 3,12 9,9 10,9 8,8 8,3 8,6 8,2 8,1 10,10 9,5 10,4 9,4 9,6 9,2 9,1 10,7 6,10 6,7 9,10 8,10 11,8"}
+};
+
+// the positions where the player has a forced win by fours, so that the AI checks every root move for a defense before the search, which once took more than 400 ms at any time budget
+const benchmark_position vcf_defense_positions[] {
+    {20, "7,7 8,8 7,9 8,6 7,8 7,6 7,10 7,11 8,9 9,9 9,10 6,7 8,10 10,10 6,10 5,10 6,11 9,8 6,8"},
+    {20, "7,7 7,8 6,8 6,7 8,6 5,9 9,5 10,4 10,6 5,6 4,5 5,8 5,7 7,9 4,9 4,7 6,9 3,8 2,9 8,4 9,4 9,6 7,5 7,4 6,5 8,5 3,5 5,5 4,6 2,4 10,7 5,4 5,3 6,3 5,2 6,4 4,4 6,2 4,2 4,3 10,8 8,9 9,10 10,9 11,9 9,7 10,10 6,1 6,0 7,3 2,6 1,7 7,1 8,2 9,1 8,1 8,3 7,2 9,0 10,2 9,2 9,3 12,8 11,1 12,0 5,1 4,0 13,7 13,9 11,7 10,0 11,5 12,6 8,0 12,7"}
+};
+
+// the position where the player's open three wins by fours and only the two ends of the three stop it, so that a small solver budget runs out after the first defense is found
+const benchmark_position vcf_budget_position {20, "7,5 9,9 7,6 10,11 7,7"};
+
+// the search options set by the command-line options, which every search of the benchmark and its checks starts from
+search_settings benchmark_settings;
+
+
+int read_benchmark_positions(const char *p_positions_path, std::vector<benchmark_position> &ref_positions);
+int run_benchmark(const std::vector<benchmark_position> &ref_positions, int fixed_depth, long long node_budget, bool is_csv_output);
+void set_up_benchmark_search(search_context &ref_context, transposition_table &ref_table, const std::vector<int> &ref_moves, int frontier_radius);
+int check_move_times(const std::vector<benchmark_position> &ref_positions, int time_budget_milliseconds);
+int check_root_split(const std::vector<benchmark_position> &ref_positions, int fixed_depth);
+int check_vcf_budget();
+int check_node_budget(const std::vector<benchmark_position> &ref_positions, long long node_budget);
+
+
+int main(int argc, char *argv[])
+{
+    std::vector<benchmark_position> positions(std::begin(default_positions), std::end(default_positions));
+    int fixed_depth {0};
+    long long node_budget {0};
+    bool is_csv_output {false};
+    // the time budget of every search if the move times are checked instead of running the benchmark, or 0
+    int checked_time_budget {0};
+    bool is_root_split_checked {false};
+    bool is_vcf_budget_checked {false};
+    bool is_node_budget_checked {false};
+    int error_code {0};
+
+    initialize_zobrist_keys();
+
+    if ((error_code = initialize_pattern_values()))
+    {
+        std::cout << "[Error] The benchmark terminates at the line " << error_code << "!\n";
+        return -1;
+    }
+
+    // reads the options "--depth <depth>" to search every position to the same depth, "--nodes <nodes>" to stop every search at a fixed node count, "--positions <file>" to replace the built-in positions, "--csv" for machine-readable output, and "--search-log <file>" to log the counters of every search
+    // "--alpha-beta" searches with the plain alpha-beta search instead of the principal variation search, and "--aspiration <window>" sets the aspiration window, where 0 disables it
+    // "--no-reductions" disables the late move reductions, "--futility <margin>" sets the futility margin, where 0 disables futility pruning, and "--quiescence <depth>" sets the depth of the quiescence search, where 0 disables it
+    // "--check-time <milliseconds>" searches every position with the time budget instead, and fails if any search takes more than twice the budget
+    // "--check-threads" searches every position with the root split on several thread counts instead, and fails if the move or the value depends on the thread count
+    // "--check-nodes" searches every position with the node budget of "--nodes", or 100000 nodes, on 1 and 4 threads instead, and fails if the threads together search more than the budget and a few checks of slack
+    // "--check-vcf-budget" filters the root moves of the positions with a forced win of the player under tiny solver budgets instead, and fails if a budget that runs out changes the root moves
+    for (int index {1}; index < argc && !error_code; index++)
+    {
+        std::string option {argv[index]};
+
+        if (option == "--depth" && index + 1 < argc)
+            fixed_depth = std::atoi(argv[++index]);
+        else if (option == "--nodes" && index + 1 < argc)
+            node_budget = std::atoll(argv[++index]);
+        else if (option == "--positions" && index + 1 < argc)
+            error_code = read_benchmark_positions(argv[++index], positions);
+        else if (option == "--csv")
+            is_csv_output = true;
+        else if (option == "--search-log" && index + 1 < argc)
+            benchmark_settings.p_search_log_path = argv[++index];
+        else if (option == "--alpha-beta")
+            benchmark_settings.is_principal_variation_search = false;
+        else if (option == "--aspiration" && index + 1 < argc)
+            benchmark_settings.aspiration_window = std::atoi(argv[++index]);
+        else if (option == "--no-reductions")
+            benchmark_settings.is_late_move_reduction_enabled = false;
+        else if (option == "--futility" && index + 1 < argc)
+            benchmark_settings.futility_margin = std::atoi(argv[++index]);
+        else if (option == "--quiescence" && index + 1 < argc)
+            benchmark_settings.max_quiescence_depth = std::atoi(argv[++index]);
+        else if (option == "--check-time" && index + 1 < argc && (checked_time_budget = std::atoi(argv[++index])) > 0)
+            continue;
+        else if (option == "--check-threads")
+            is_root_split_checked = true;
+        else if (option == "--check-vcf-budget")
+            is_vcf_budget_checked = true;
+        else if (option == "--check-nodes")
+            is_node_budget_checked = true;
+        else
+            error_code = __LINE__;
+    }
+
+    if (!error_code && checked_time_budget > 0)
+        error_code = check_move_times(positions, checked_time_budget);
+    else if (!error_code && is_root_split_checked)
+        error_code = check_root_split(positions, fixed_depth);
+    else if (!error_code && is_vcf_budget_checked)
+        error_code = check_vcf_budget();
+    else if (!error_code && is_node_budget_checked)
+        error_code = check_node_budget(positions, node_budget > 0 ? node_budget : 100000);
+    else if (!error_code)
+        error_code = run_benchmark(positions, fixed_depth, node_budget, is_csv_output);
+
+    if (error_code)
+    {
+        std::cout << "[Error] The benchmark terminates at the line " << error_code << "!\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: reads benchmark positions from a text file, where each line holds the search depth followed by the moves, and empty lines and lines starting with '#' are skipped
+<Parameter "p_positions_path"> :: the path of the position file
+<Parameter "ref_positions"> :: a reference to the vector storing the positions, which replace the built-in positions
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int read_benchmark_positions(const char *p_positions_path, std::vector<benchmark_position> &ref_positions)
+{
+    std::ifstream positions_file {p_positions_path};
+    std::string position_line;
+
+    // exits the current function if the position file is missing
+    if (!positions_file)
+        return __LINE__;
+
+    ref_positions.clear();
+
+    while (std::getline(positions_file, position_line))
+    {
+        benchmark_position position;
+        std::size_t separator;
+
+        if (position_line.empty() || position_line[0] == '#' || position_line[0] == '\r')
+            continue;
+
+        separator = position_line.find(' ');
+        position.search_depth = std::atoi(position_line.c_str());
+        position.moves_text = separator == std::string::npos ? "" : position_line.substr(separator + 1);
+
+        // exits the current function if a line does not start with a positive depth
+        if (position.search_depth < 1)
+            return __LINE__;
+
+        ref_positions.push_back(position);
+    }
+
+    if (ref_positions.empty())
+        return __LINE__;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: searches every benchmark position on one thread with an empty transposition table, and shows the result of each position and the totals
+<Parameter "ref_positions"> :: a reference to the benchmark positions
+<Parameter "fixed_depth"> :: the depth of every search, or 0 to use the depth of each position
+<Parameter "node_budget"> :: the node count at which every search stops, or 0 for no limit
+<Parameter "is_csv_output"> :: whether the results are written as comma-separated values instead of text
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int run_benchmark(const std::vector<benchmark_position> &ref_positions, int fixed_depth, long long node_budget, bool is_csv_output)
+{
+    search_context *p_context {new search_context};
+    transposition_table table;
+    search_settings settings {benchmark_settings};
+    long long total_nodes {0};
+    long long total_milliseconds {0};
+    // the FNV-1a hash of the moves, values, and node counts of every position, which is the same in every run unless the search changes
+    unsigned long long signature {14695981039346656037ULL};
+
+    // searches without a time limit on one thread, so that the results only depend on the search itself
+    settings.time_budget_milliseconds = 1 << 30;
+    settings.node_budget = node_budget;
+    settings.total_threads = 1;
+    settings.is_root_split = false;
+
+    if (is_csv_output)
+        std::cout << "position,stones,depth,completed_depth,row,column,value,nodes,vcf_nodes,milliseconds,nodes_per_second,forced_win\n";
+
+    for (int index {0}; index < static_cast<int>(ref_positions.size()); index++)
+    {
+        std::vector<int> moves;
+        search_report report;
+        int best_move;
+        int error_code;
+
+        if ((error_code = read_book_record(ref_positions[index].moves_text, moves)))
+        {
+            delete p_context;
+            return error_code;
+        }
+
+        // exits the current function if a position has no stone or is already decided
+        set_up_benchmark_search(*p_context, table, moves, settings.frontier_radius);
+        if (moves.empty() || check_battle_state(p_context->position))
+        {
+            delete p_context;
+            return __LINE__;
+        }
+
+        settings.max_search_depth = fixed_depth > 0 ? fixed_depth : ref_positions[index].search_depth;
+
+        best_move = search_ai_move(*p_context, settings, report);
+
+        total_nodes += report.total_nodes + report.vcf_nodes;
+        total_milliseconds += report.elapsed_milliseconds;
+
+        for (long long signature_value : {static_cast<long long>(best_move), static_cast<long long>(report.board_value), report.total_nodes, report.vcf_nodes})
+        {
+            for (int byte {0}; byte < 8; byte++)
+            {
+                signature ^= static_cast<unsigned long long>(signature_value >> (byte * 8)) & 0xFF;
+                signature *= 1099511628211ULL;
+            }
+        }
+
+        if (is_csv_output)
+        {
+            std::cout << index + 1 << ',' << moves.size() << ',' << settings.max_search_depth << ',' << report.completed_depth << ',' << best_move / 15 << ',' << best_move % 15 << ',' << report.board_value << ',';
+            std::cout << report.total_nodes << ',' << report.vcf_nodes << ',' << report.elapsed_milliseconds << ',' << report.nodes_per_second << ',' << (report.is_forced_win ? 1 : 0) << '\n';
+        }
+        else
+        {
+            std::cout << "position " << std::setw(2) << index + 1 << " (" << std::setw(2) << moves.size() << " stones): depth " << report.completed_depth << "/" << settings.max_search_depth;
+            std::cout << ", move (" << best_move / 15 << ", " << best_move % 15 << "), value " << report.board_value << ", " << report.total_nodes << " nodes + " << report.vcf_nodes << " vcf nodes";
+            std::cout << ", " << report.elapsed_milliseconds << " ms to depth, " << report.nodes_per_second << " nodes/s" << (report.is_forced_win ? ", forced win" : "") << '\n';
+        }
+    }
+
+    delete p_context;
+
+    if (is_csv_output)
+    {
+        std::cout << "total,,,,,,," << total_nodes << ",," << total_milliseconds << ',' << total_nodes * 1000 / std::max(1LL, total_milliseconds) << ",\n";
+        std::cout << "signature," << std::hex << signature << std::dec << '\n';
+    }
+    else
+    {
+        std::cout << "total: " << total_nodes << " nodes in " << total_milliseconds << " ms, " << total_nodes * 1000 / std::max(1LL, total_milliseconds) << " nodes/s\n";
+        std::cout << "signature: " << std::hex << signature << std::dec << '\n';
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: sets up the search of a benchmark position with an empty transposition table and without an opening book, a random engine, or a Monte Carlo search tree, so that each search only depends on its position
+<Parameter "ref_context"> :: a reference to the search context
+<Parameter "ref_table"> :: a reference to the transposition table, which is cleared
+<Parameter "ref_moves"> :: a reference to the moves of the position, encoded as (row * 15 + column)
+<Parameter "frontier_radius"> :: the square radius around the stones where the candidate moves are generated
+<Return> :: none
+*/
+void set_up_benchmark_search(search_context &ref_context, transposition_table &ref_table, const std::vector<int> &ref_moves, int frontier_radius)
+{
+    set_up_game_position(ref_context.position, ref_moves, static_cast<int>(ref_moves.size()), frontier_radius);
+    clear_transposition_table(ref_table, 1 << 18);
+    prepare_search_context(ref_context, &ref_table, nullptr, nullptr, nullptr);
+
+    return;
+}
+
+
+/*
+<Summary> :: searches every benchmark position and every position with a forced win of the player under a time budget on one thread, and shows the time of each search
+<Parameter "ref_positions"> :: a reference to the benchmark positions, which are searched before the built-in positions with a forced win of the player
+<Parameter "time_budget_milliseconds"> :: the time budget of every search
+<Return> :: the return value would be 0 if every search takes at most twice the budget; otherwise the return value would be the line number where the error occurs
+*/
+int check_move_times(const std::vector<benchmark_position> &ref_positions, int time_budget_milliseconds)
+{
+    search_context *p_context {new search_context};
+    transposition_table table;
+    search_settings settings {benchmark_settings};
+    std::vector<benchmark_position> positions {ref_positions};
+    long long max_milliseconds {0};
+    int error_code {0};
+
+    settings.time_budget_milliseconds = time_budget_milliseconds;
+    settings.total_threads = 1;
+    settings.is_root_split = false;
+
+    positions.insert(positions.end(), std::begin(vcf_defense_positions), std::end(vcf_defense_positions));
+
+    for (int index {0}; index < static_cast<int>(positions.size()) && !error_code; index++)
+    {
+        std::vector<int> moves;
+        search_report report;
+
+        if ((error_code = read_book_record(positions[index].moves_text, moves)))
+            break;
+
+        set_up_benchmark_search(*p_context, table, moves, settings.frontier_radius);
+
+        search_ai_move(*p_context, settings, report);
+        max_milliseconds = std::max(max_milliseconds, report.elapsed_milliseconds);
+
+        std::cout << "position " << std::setw(2) << index + 1 << " (" << std::setw(2) << moves.size() << " stones): depth " << report.completed_depth << ", " << report.elapsed_milliseconds << " ms, " << report.vcf_nodes << " vcf nodes\n";
+
+        // exits the current function if a search overruns the budget by more than the budget itself
+        if (report.elapsed_milliseconds > 2LL * time_budget_milliseconds)
+            error_code = __LINE__;
+    }
+
+    delete p_context;
+
+    if (!error_code)
+        std::cout << "every search took at most " << max_milliseconds << " ms for a budget of " << time_budget_milliseconds << " ms\n";
+
+    return error_code;
+}
+
+
+/*
+<Summary> :: searches every benchmark position with the root split on 1, 2, 3, and 7 threads under the current settings, and shows the move and value of each thread count
+every position is searched once with the quiescence search, which must be reached at the horizon, and once without it
+<Parameter "ref_positions"> :: a reference to the benchmark positions
+<Parameter "fixed_depth"> :: the depth of every search, or 0 for the depth of each position but at most 5, which keeps the check short on a machine with few cores
+<Return> :: the return value would be 0 if every thread count finds the same move and value at each position and with each quiescence depth; otherwise the return value would be the line number where the error occurs
+*/
+int check_root_split(const std::vector<benchmark_position> &ref_positions, int fixed_depth)
+{
+    search_context *p_context {new search_context};
+    transposition_table table;
+    search_settings settings {benchmark_settings};
+    int error_code {0};
+
+    settings.time_budget_milliseconds = 1 << 30;
+    settings.node_budget = 0;
+    settings.is_root_split = true;
+
+    for (int index {0}; index < static_cast<int>(ref_positions.size()) * 2 && !error_code; index++)
+    {
+        const benchmark_position &ref_position {ref_positions[index / 2]};
+        std::vector<int> moves;
+        int first_move {-1};
+        int first_value {0};
+
+        if ((error_code = read_book_record(ref_position.moves_text, moves)))
+            break;
+
+        // searches each position with the quiescence depth of the settings, or 6 if the settings disable it, and then without the quiescence search
+        settings.max_quiescence_depth = index % 2 == 1 ? 0 : (benchmark_settings.max_quiescence_depth > 0 ? benchmark_settings.max_quiescence_depth : 6);
+        settings.max_search_depth = fixed_depth > 0 ? fixed_depth : std::min(ref_position.search_depth, 5);
+        std::cout << "position " << std::setw(2) << index / 2 + 1 << " (" << std::setw(2) << moves.size() << " stones), depth " << settings.max_search_depth << ", quiescence " << settings.max_quiescence_depth << ':';
+
+        for (int total_threads : {1, 2, 3, 7})
+        {
+            search_report report;
+            int best_move;
+
+            set_up_benchmark_search(*p_context, table, moves, settings.frontier_radius);
+
+            settings.total_threads = total_threads;
+
+            best_move = search_ai_move(*p_context, settings, report);
+
+            std::cout << ' ' << total_threads << " threads (" << best_move / 15 << ", " << best_move % 15 << ") " << report.board_value;
+
+            if (first_move == -1)
+            {
+                first_move = best_move;
+                first_value = report.board_value;
+            }
+            else if (best_move != first_move || report.board_value != first_value)
+            {
+                error_code = __LINE__;
+            }
+
+            // exits the current function if the quiescence search is never reached, which would leave it unchecked
+            if (settings.max_quiescence_depth > 0 && report.counters.quiescence_nodes == 0)
+                error_code = __LINE__;
+        }
+
+        std::cout << '\n';
+    }
+
+    delete p_context;
+
+    return error_code;
+}
+
+
+/*
+<Summary> :: filters the root moves of every built-in position with a forced win of the player under solver budgets growing by about 6% from 1 node up to 4096 nodes, where most budgets run out among the defense checks, some after a defense has been found
+<Return> :: the return value would be 0 if every budget that runs out leaves the root moves unchanged, every completed filter keeps distinct root moves, and at least one budget runs out among the defense checks; otherwise the return value would be the line number where the error occurs
+*/
+int check_vcf_budget()
+{
+    search_context *p_context {new search_context};
+    search_settings settings {benchmark_settings};
+    std::vector<benchmark_position> positions(std::begin(vcf_defense_positions), std::end(vcf_defense_positions));
+    int total_exhausted_filters {0};
+    int error_code {0};
+
+    positions.push_back(vcf_budget_position);
+
+    for (int index {0}; index < static_cast<int>(positions.size()) && !error_code; index++)
+    {
+        std::vector<int> moves;
+
+        if ((error_code = read_book_record(positions[index].moves_text, moves)))
+            break;
+
+        set_up_game_position(p_context->position, moves, static_cast<int>(moves.size()), settings.frontier_radius);
+        prepare_search_context(*p_context, nullptr, nullptr, nullptr, nullptr);
+
+        for (long long vcf_node_budget {1}; vcf_node_budget <= 4096 && !error_code; vcf_node_budget += vcf_node_budget / 16 + 1)
+        {
+            int root_moves[225];
+            int total_root_moves;
+            int total_remaining_moves;
+            bool is_kept[225] {};
+
+            p_context->deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+            p_context->vcf_nodes = 0;
+            p_context->total_root_moves = generate_candidate_moves(p_context->position, p_context->root_moves);
+            total_root_moves = p_context->total_root_moves;
+            std::copy(p_context->root_moves, p_context->root_moves + total_root_moves, root_moves);
+
+            settings.vcf_node_budget = vcf_node_budget;
+            total_remaining_moves = filter_vcf_defenses(*p_context, settings);
+
+            // a filter that returns every root move after its budget ran out must leave them in their order
+            if (total_remaining_moves == total_root_moves && !std::equal(root_moves, root_moves + total_root_moves, p_context->root_moves))
+                error_code = __LINE__;
+
+            if (total_remaining_moves == total_root_moves && p_context->vcf_nodes >= p_context->vcf_node_limit)
+                total_exhausted_filters++;
+
+            for (int move_index {0}; move_index < total_remaining_moves && !error_code; move_index++)
+            {
+                int move {p_context->root_moves[move_index]};
+
+                if (is_kept[move] || std::find(root_moves, root_moves + total_root_moves, move) == root_moves + total_root_moves)
+                    error_code = __LINE__;
+
+                is_kept[move] = true;
+            }
+
+            std::cout << "position " << index + 1 << ", budget " << std::setw(4) << vcf_node_budget << ": " << total_remaining_moves << " of " << total_root_moves << " root moves, " << p_context->vcf_nodes << " vcf nodes\n";
+        }
+    }
+
+    delete p_context;
+
+    // exits the current function if no budget runs out, which would leave the check without a case
+    if (!error_code && total_exhausted_filters == 0)
+        error_code = __LINE__;
+
+    return error_code;
+}
+
+
+/*
+<Summary> :: searches every benchmark position under a node budget with Lazy SMP and with the root split on 1 and 4 threads, and shows the nodes of each search
+<Parameter "ref_positions"> :: a reference to the benchmark positions
+<Parameter "node_budget"> :: the node budget of every search, which is small enough to stop every search before its depth
+<Return> :: the return value would be 0 if no search passes the budget by more than 2048 nodes per thread, which are the nodes that a thread may search between two checks of the budget; otherwise the return value would be the line number where the error occurs
+*/
+int check_node_budget(const std::vector<benchmark_position> &ref_positions, long long node_budget)
+{
+    search_context *p_context {new search_context};
+    transposition_table table;
+    search_settings settings {benchmark_settings};
+    int error_code {0};
+
+    settings.time_budget_milliseconds = 1 << 30;
+    settings.node_budget = node_budget;
+    settings.max_search_depth = 20;
+
+    for (int index {0}; index < static_cast<int>(ref_positions.size()) && !error_code; index++)
+    {
+        std::vector<int> moves;
+
+        if ((error_code = read_book_record(ref_positions[index].moves_text, moves)))
+            break;
+
+        std::cout << "position " << std::setw(2) << index + 1 << " (" << std::setw(2) << moves.size() << " stones):";
+
+        for (bool is_root_split : {false, true})
+        {
+            for (int total_threads : {1, 4})
+            {
+                search_report report;
+
+                set_up_benchmark_search(*p_context, table, moves, settings.frontier_radius);
+
+                settings.total_threads = total_threads;
+                settings.is_root_split = is_root_split;
+
+                search_ai_move(*p_context, settings, report);
+
+                std::cout << ' ' << (is_root_split ? "split " : "smp ") << total_threads << " threads " << report.total_nodes;
+
+                if (report.total_nodes > node_budget + 2048LL * total_threads)
+                    error_code = __LINE__;
+            }
+        }
+
+        std::cout << '\n';
+    }
+
+    delete p_context;
+
+    return error_code;
+}
@@ -1,6 +1,11 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <atomic>
 
 // includes Windows API to perform OS-related tasks
 #include <windows.h>
@@ -8,11 +13,41 @@
 // includes the non-standard _getch() function to read keyboard inputs without echo
 #include <conio.h>
 
+// includes the search and evaluation engine, which is compiled from gomoku_engine.cpp and shared with the headless engine
+#include "gomoku_engine.h"
+
+
+/*
+<Summary> :: the background search that the AI runs during the player's turn, which assumes that the player plays the predicted reply
+*/
+struct ponder_state
+{
+    std::thread thread;
+    bool is_running;
+    // the player's reply assumed by the background search, encoded as (row * 15 + column)
+    int predicted_move;
+    search_context *p_context;
+    search_settings settings;
+    search_report report;
+    int best_move;
+    // the signal that discards the search at once if the player does not play the predicted reply
+    std::atomic<bool> cancel_signal;
+    // the signal that ends the search after its current iteration if the player plays the predicted reply
+    std::atomic<bool> finish_signal;
+};
+
 
 bool is_player_turn;
-int gomoku_board[15][15];
-int last_placed_row;
-int last_placed_column;
+// the budgets and options of the AI, which the command-line options may change
+search_settings battle_settings;
+bitboard_position battle_position;
+transposition_table battle_table;
+mcts_tree battle_tree;
+search_report last_search_report;
+ponder_state battle_ponder;
+opening_book battle_book;
+// the random engine picking among the book replies, which the main search and the pondering share since they never run at the same time
+std::mt19937 battle_random_engine;
 
 
 int set_up_console();
@@ -45,18 +80,10 @@ bool check_valid_placement(INPUT_RECORD input_record, COORD &ref_character_posit
 void refresh_gomoku_board(COORD character_position_of_click);
 int perform_ai_move();
 void calculate_ai_move(COORD &ref_character_position_of_click, int &ref_placed_row, int &ref_placed_column);
-bool check_neighbors(int row, int column);
-double predict_board_value(bool is_player_next, int search_depth, double max_board_value, double min_board_value);
-bool check_battle_state();
-double assess_board_value();
-double assess_stone_top(int row, int column);
-double assess_stone_bottom(int row, int column);
-double assess_stone_left(int row, int column);
-double assess_stone_right(int row, int column);
-double assess_stone_top_left(int row, int column);
-double assess_stone_top_right(int row, int column);
-double assess_stone_bottom_left(int row, int column);
-double assess_stone_bottom_right(int row, int column);
+void start_pondering();
+void ponder_player_reply();
+void cancel_pondering();
+bool finish_pondering(int &ref_best_move);
 int end_battle(bool &ref_is_game_running);
 int check_winner();
 void highlight_winner_vertical(int end_row, int end_column);
@@ -67,22 +94,64 @@ void show_ending_message(int winner);
 int check_next_battle(bool &ref_is_game_running);
 
 
-int main()
+int main(int argc, char *argv[])
 {
     int error_code;
 
+    // runs the proof-number analysis of a board file without the game interface if the program is started as "gomoku --solve <board file> <X or O> [node limit]"
+    if (argc >= 4 && std::string {argv[1]} == "--solve")
+    {
+        initialize_zobrist_keys();
+
+        if ((error_code = initialize_pattern_values()) || (error_code = run_proof_analysis(argv[2], argv[3], argc >= 5 ? std::atoll(argv[4]) : 1000000)))
+        {
+            std::cout << "[Error] The analysis terminates at the line " << error_code << "!\n";
+            return -1;
+        }
+
+        return 0;
+    }
+
+    // builds or extends the opening book without the game interface if the program is started as "gomoku --build-book <book file> <source> ..."
+    if (argc >= 4 && std::string {argv[1]} == "--build-book")
+    {
+        initialize_zobrist_keys();
+
+        if ((error_code = initialize_pattern_values()) || (error_code = run_book_builder(argc, argv, battle_settings)))
+        {
+            std::cout << "[Error] The book builder terminates at the line " << error_code << "!\n";
+            return -1;
+        }
+
+        return 0;
+    }
+
+    // appends the counters of every AI move to a log file if the program is started as "gomoku --search-log <log file>"
+    if (argc >= 3 && std::string {argv[1]} == "--search-log")
+        battle_settings.p_search_log_path = argv[2];
+
     if ((error_code = set_up_console()))
     {
         show_error_message(error_code);
         return -1;
     }
 
+    initialize_zobrist_keys();
+
+    if ((error_code = initialize_pattern_values()) || (error_code = open_opening_book(battle_book, "opening_book.bin")))
+    {
+        show_error_message(error_code);
+        return -1;
+    }
+
     if ((error_code = start_game()))
     {
         show_error_message(error_code);
         return -1;
     }
 
+    close_opening_book(battle_book);
+
     return 0;
 }
 
@@ -795,7 +864,7 @@ int start_battle(bool &ref_is_game_running)
                 return error_code;
             is_player_turn = true;
         }
-    } while (!check_battle_state());
+    } while (!check_battle_state(battle_position));
 
     if ((error_code = end_battle(ref_is_game_running)))
         return error_code;
@@ -805,18 +874,18 @@ int start_battle(bool &ref_is_game_running)
 
 
 /*
-<Summary> :: initializes the Gomoku board, last move record, and battle interface
+<Summary> :: initializes the bitboard position of the Gomoku board with its last move record, the transposition table, the Monte Carlo search tree, and the battle interface
 <Parameters> :: none
 <Return> :: none
 */
 void initialize_battle()
 {
-    for (int row {0}; row < 15; row++)
-        for (int column {0}; column < 15; column++)
-            gomoku_board[row][column] = 0;
+    clear_position(battle_position, battle_settings.frontier_radius);
 
-    last_placed_row = -1;
-    last_placed_column = -1;
+    // allocates 2^18 buckets of 64 bytes, which takes 16 MB of memory
+    clear_transposition_table(battle_table, 1 << 18);
+    clear_mcts_tree(battle_tree, 1 << 20);
+    battle_random_engine.seed(std::random_device {}());
 
     std::cout << "\n\n";
 
@@ -875,18 +944,28 @@ int read_player_move()
     move_cursor(34, 17);
     std::cout << "   輪到你的回合，在棋盤上的空位點擊滑鼠左鍵放置棋子    ";
 
+    start_pondering();
+
     if ((error_code = read_stone_placement(character_position_of_click, placed_row, placed_column)))
+    {
+        cancel_pondering();
         return error_code;
+    }
 
-    // plays asynchronous sound effects when a stone is placed, and exits the current function if the sound effects are not played successfully
+    // plays asynchronous sound effects when a stone is placed, and exits the current function after stopping the pondering if the sound effects are not played successfully
     if (!PlaySound(TEXT("placing_stone.wav"), NULL, SND_FILENAME | SND_ASYNC))
+    {
+        cancel_pondering();
         return __LINE__;
+    }
 
     refresh_gomoku_board(character_position_of_click);
 
-    gomoku_board[placed_row][placed_column] = 1;
-    last_placed_row = placed_row;
-    last_placed_column = placed_column;
+    make_move(battle_position, placed_row, placed_column, 1);
+
+    // keeps pondering for the AI's move only if the player has played the predicted reply and the battle goes on
+    if (battle_ponder.predicted_move != placed_row * 15 + placed_column || check_battle_state(battle_position))
+        cancel_pondering();
 
     return 0;
 }
@@ -955,7 +1034,7 @@ bool check_valid_placement(INPUT_RECORD input_record, COORD &ref_character_posit
                     int clicked_row {(mouse_event.dwMousePosition.Y - 2) / 2};
                     int clicked_column {(mouse_event.dwMousePosition.X - 15) / 4};
 
-                    if (gomoku_board[clicked_row][clicked_column] == 0)
+                    if (get_stone(battle_position, clicked_row, clicked_column) == 0)
                     {
                         ref_character_position_of_click = mouse_event.dwMousePosition;
                         ref_placed_row = clicked_row;
@@ -983,11 +1062,11 @@ void refresh_gomoku_board(COORD character_position_of_click)
         move_cursor(character_position_of_click.Y + 1, character_position_of_click.X + 1);
         std::cout << "O";
 
-        if (last_placed_row != -1 || last_placed_column != -1)
+        if (battle_position.last_placed_row != -1 || battle_position.last_placed_column != -1)
         {
             COORD last_placed_character_position {
-                static_cast<SHORT>(last_placed_column * 4 + 15),
-                static_cast<SHORT>(last_placed_row * 2 + 2)
+                static_cast<SHORT>(battle_position.last_placed_column * 4 + 15),
+                static_cast<SHORT>(battle_position.last_placed_row * 2 + 2)
             };
 
             move_cursor(last_placed_character_position.Y + 1, last_placed_character_position.X + 1);
@@ -1022,8 +1101,6 @@ int perform_ai_move()
     move_cursor(34, 17);
     std::cout << "          輪到對手的回合，等待他完成下一步棋           ";
 
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-
     calculate_ai_move(character_position_of_click, placed_row, placed_column);
 
     // plays asynchronous sound effects when a stone is placed, and exits the current function if the sound effects are not played successfully
@@ -1032,16 +1109,14 @@ int perform_ai_move()
 
     refresh_gomoku_board(character_position_of_click);
 
-    gomoku_board[placed_row][placed_column] = -1;
-    last_placed_row = placed_row;
-    last_placed_column = placed_column;
+    make_move(battle_position, placed_row, placed_column, -1);
 
     return 0;
 }
 
 
 /*
-<Summary> :: calculates the AI's next move using the minimax algorithm with alpha-beta pruning, and stores the placement information to specified variables
+<Summary> :: calculates the AI's next move within the time budget of the AI settings, or takes it from the pondering, and stores the placement information to specified variables
 <Parameter "ref_character_position_of_click"> :: a reference to the structure storing the character coordinates of the placed stone
 <Parameter "ref_placed_row"> :: a reference to the variable storing the row where the AI places the stone
 <Parameter "ref_placed_column"> :: a reference to the variable storing the column where the AI places the stone
@@ -1049,482 +1124,155 @@ int perform_ai_move()
 */
 void calculate_ai_move(COORD &ref_character_position_of_click, int &ref_placed_row, int &ref_placed_column)
 {
-    if (last_placed_row == -1 && last_placed_column == -1)
-    {
-        ref_placed_row = 7;
-        ref_placed_column = 7;
-        ref_character_position_of_click.X = ref_placed_column * 4 + 15;
-        ref_character_position_of_click.Y = ref_placed_row * 2 + 2;
-    }
-    else
-    {
-        double max_board_value {std::numeric_limits<double>::lowest()};
-        double min_board_value {std::numeric_limits<double>::max()};
-
-        for (int row {0}; row < 15; row++)
-        {
-            for (int column {0}; column < 15; column++)
-            {
-                if (gomoku_board[row][column] == 0 && check_neighbors(row, column))
-                {
-                    int temp_row;
-                    int temp_column;
-                    double board_value;
-
-                    gomoku_board[row][column] = -1;
-                    temp_row = last_placed_row;
-                    temp_column = last_placed_column;
-                    last_placed_row = row;
-                    last_placed_column = column;
-
-                    board_value = predict_board_value(true, 2, max_board_value, min_board_value);
-
-                    gomoku_board[row][column] = 0;
-                    last_placed_row = temp_row;
-                    last_placed_column = temp_column;
-
-                    if (board_value > max_board_value)
-                    {
-                        max_board_value = board_value;
-                        ref_placed_row = row;
-                        ref_placed_column = column;
-                    }
-                }
-            }
-        }
-
-        ref_character_position_of_click.X = ref_placed_column * 4 + 15;
-        ref_character_position_of_click.Y = ref_placed_row * 2 + 2;
-    }
-
-    return;
-}
-
-
-/*
-<Summary> :: checks whether a specified position of the gomoku board has any adjacent stones
-<Parameter "row"> :: a row index of the gomoku board
-<Parameter "column"> :: a column index of the gomoku board
-<Return> :: whether the specified position of the gomoku board has any adjacent stones
-*/
-bool check_neighbors(int row, int column)
-{
-    if (row - 1 >= 0 && column - 1 >= 0)
-        if (gomoku_board[row - 1][column - 1] != 0)
-            return true;
-
-    if (row - 1 >= 0)
-        if (gomoku_board[row - 1][column] != 0)
-            return true;
-
-    if (row - 1 >= 0 && column + 1 <= 14)
-        if (gomoku_board[row - 1][column + 1] != 0)
-            return true;
-
-    if (column - 1 >= 0)
-        if (gomoku_board[row][column - 1] != 0)
-            return true;
-
-    if (column + 1 <= 14)
-        if (gomoku_board[row][column + 1] != 0)
-            return true;
-
-    if (row + 1 <= 14 && column - 1 >= 0)
-        if (gomoku_board[row + 1][column - 1] != 0)
-            return true;
+    search_context context;
+    int best_move;
 
-    if (row + 1 <= 14)
-        if (gomoku_board[row + 1][column] != 0)
-            return true;
-
-    if (row + 1 <= 14 && column + 1 <= 14)
-        if (gomoku_board[row + 1][column + 1] != 0)
-            return true;
-
-    return false;
-}
-
-
-/*
-<Summary> :: predicts the board value using the minimax algorithm with alpha-beta pruning
-<Parameter "is_player_next"> :: whether the player moves next
-<Parameter "search_depth"> :: the number of moves to be predicted
-<Parameter "max_board_value"> :: the maximum board value that the AI has found
-<Parameter "min_board_value"> :: the minimum board value that the player has found
-<Return> :: the predicted board value
-*/
-double predict_board_value(bool is_player_next, int search_depth, double max_board_value, double min_board_value)
-{
-    // returns the current board value if a leaf node of recursion tree is found
-    if (search_depth == 0 || check_battle_state())
-        return assess_board_value();
-
-    // calculates and returns the minimum board value for the player turn
-    if (is_player_next)
+    // searches the position only if the pondering did not predict the player's reply
+    if (!finish_pondering(best_move))
     {
-        for (int row {0}; row < 15; row++)
-        {
-            for (int column {0}; column < 15; column++)
-            {
-                if (gomoku_board[row][column] == 0 && check_neighbors(row, column))
-                {
-                    int temp_row;
-                    int temp_column;
-                    double board_value;
-
-                    gomoku_board[row][column] = 1;
-                    temp_row = last_placed_row;
-                    temp_column = last_placed_column;
-                    last_placed_row = row;
-                    last_placed_column = column;
+        context.position = battle_position;
+        prepare_search_context(context, &battle_table, &battle_book, &battle_random_engine, &battle_tree);
 
-                    board_value = predict_board_value(!is_player_next, search_depth - 1, max_board_value, min_board_value);
-
-                    gomoku_board[row][column] = 0;
-                    last_placed_row = temp_row;
-                    last_placed_column = temp_column;
-
-                    if (board_value < min_board_value)
-                        min_board_value = board_value;
-
-                    if (min_board_value <= max_board_value)
-                        return min_board_value;
-                }
-            }
-        }
-
-        return min_board_value;
+        best_move = search_ai_move(context, battle_settings, last_search_report);
     }
-    // calculates and returns the maximum board value for the AI turn
-    else
-    {
-        for (int row {0}; row < 15; row++)
-        {
-            for (int column {0}; column < 15; column++)
-            {
-                if (gomoku_board[row][column] == 0 && check_neighbors(row, column))
-                {
-                    int temp_row;
-                    int temp_column;
-                    double board_value;
-
-                    gomoku_board[row][column] = -1;
-                    temp_row = last_placed_row;
-                    temp_column = last_placed_column;
-                    last_placed_row = row;
-                    last_placed_column = column;
 
-                    board_value = predict_board_value(!is_player_next, search_depth - 1, max_board_value, min_board_value);
+    // opens at the center if the board is empty, where the search has no move, since the battle ends in a tie before the board is full
+    if (best_move == -1)
+        best_move = 7 * 15 + 7;
 
-                    gomoku_board[row][column] = 0;
-                    last_placed_row = temp_row;
-                    last_placed_column = temp_column;
+    ref_placed_row = best_move / 15;
+    ref_placed_column = best_move % 15;
 
-                    if (board_value > max_board_value)
-                        max_board_value = board_value;
+    ref_character_position_of_click.X = ref_placed_column * 4 + 15;
+    ref_character_position_of_click.Y = ref_placed_row * 2 + 2;
 
-                    if (min_board_value <= max_board_value)
-                        return max_board_value;
-                }
-            }
-        }
-
-        return max_board_value;
-    }
+    return;
 }
 
 
 /*
-<Summary> :: checks whether the player of the last move wins or the battle ends in a tie
+<Summary> :: predicts the player's reply to the AI's last move, and starts searching the AI's answer to it on a background thread while the player thinks
 <Parameters> :: none
-<Return> :: whether the battle is over
+<Return> :: none
 */
-bool check_battle_state()
+void start_pondering()
 {
-    int last_moved_player {gomoku_board[last_placed_row][last_placed_column]};
+    int moves[225];
+    int total_moves;
+    int predicted_move;
+    int symmetry;
+    unsigned long long search_key;
+    int stored_value;
 
-    // checks whether the player of the last move forms an unbroken line of five stones vertically
-    for (int total_adjacent_stones {0}, offset {-4}; offset < 5; offset++)
-    {
-        if (last_placed_row + offset >= 0 && last_placed_row + offset <= 14)
-        {
-            if (gomoku_board[last_placed_row + offset][last_placed_column] == last_moved_player)
-                total_adjacent_stones++;
-            else
-                total_adjacent_stones = 0;
-        }
-
-        if (total_adjacent_stones == 5)
-            return true;
-    }
-
-    // checks whether the player of the last move forms an unbroken line of five stones horizontally
-    for (int total_adjacent_stones {0}, offset {-4}; offset < 5; offset++)
-    {
-        if (last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
-        {
-            if (gomoku_board[last_placed_row][last_placed_column + offset] == last_moved_player)
-                total_adjacent_stones++;
-            else
-                total_adjacent_stones = 0;
-        }
-
-        if (total_adjacent_stones == 5)
-            return true;
-    }
-
-    // checks whether the player of the last move forms an unbroken diagonal line of five stones from top left to bottom right
-    for (int total_adjacent_stones {0}, offset {-4}; offset < 5; offset++)
-    {
-        if (last_placed_row + offset >= 0 && last_placed_row + offset <= 14 && last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
-        {
-            if (gomoku_board[last_placed_row + offset][last_placed_column + offset] == last_moved_player)
-                total_adjacent_stones++;
-            else
-                total_adjacent_stones = 0;
-        }
-
-        if (total_adjacent_stones == 5)
-            return true;
-    }
-
-    // checks whether the player of the last move forms an unbroken diagonal line of five stones from bottom left to top right
-    for (int total_adjacent_stones {0}, offset {-4}; offset < 5; offset++)
-    {
-        if (last_placed_row - offset >= 0 && last_placed_row - offset <= 14 && last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
-        {
-            if (gomoku_board[last_placed_row - offset][last_placed_column + offset] == last_moved_player)
-                total_adjacent_stones++;
-            else
-                total_adjacent_stones = 0;
-        }
+    if (!battle_settings.is_pondering_enabled || battle_position.total_stones == 0 || battle_ponder.is_running)
+        return;
 
-        if (total_adjacent_stones == 5)
-            return true;
-    }
-
-    // checks whether the gomoku board is completely filled with stones
-    for (int row {0}; row < 15; row++)
-        for (int column {0}; column < 15; column++)
-            if (gomoku_board[row][column] == 0)
-                return false;
-    return true;
-}
+    // predicts the best move of the player stored by the AI's last search, or the candidate move with the highest static score
+    search_key = get_search_key(battle_position, true, symmetry);
+    probe_transposition_table(battle_table, search_key, symmetry, 0, 0, false, 0, 0, stored_value, predicted_move);
 
+    // discards a stored move on an occupied point, which can only come from another position sharing the key check
+    if (predicted_move != -1 && ((battle_position.row_masks[0][predicted_move / 15] | battle_position.row_masks[1][predicted_move / 15]) >> (predicted_move % 15)) & 1)
+        predicted_move = -1;
 
-/*
-<Summary> :: assesses the total value of the current board state
-<Parameters> :: none
-<Return> :: the total value of the current board state
-*/
-double assess_board_value()
-{
-    double board_value {0.0};
-
-    for (int row {0}; row < 15; row++)
+    if (predicted_move == -1)
     {
-        for (int column {0}; column < 15; column++)
-        {
-            if (gomoku_board[row][column] != 0)
-            {
-                double stone_value {0.0};
-
-                stone_value += assess_stone_top(row, column);
-                stone_value += assess_stone_bottom(row, column);
-                stone_value += assess_stone_left(row, column);
-                stone_value += assess_stone_right(row, column);
-                stone_value += assess_stone_top_left(row, column);
-                stone_value += assess_stone_top_right(row, column);
-                stone_value += assess_stone_bottom_left(row, column);
-                stone_value += assess_stone_bottom_right(row, column);
-                stone_value += 0.1 * (15 - abs(row - 7) - abs(column - 7));
-
-                if (gomoku_board[row][column] == 1)
-                    // sets the AI to focus more on defense
-                    stone_value = -stone_value * 5;
-
-                board_value += stone_value;
-            }
-        }
+        total_moves = generate_candidate_moves(battle_position, moves);
+        if (total_moves == 0)
+            return;
+
+        predicted_move = moves[0];
+        for (int index {1}; index < total_moves; index++)
+            if (score_candidate_move(battle_position, moves[index] / 15, moves[index] % 15, 0) > score_candidate_move(battle_position, predicted_move / 15, predicted_move % 15, 0))
+                predicted_move = moves[index];
     }
 
-    return board_value;
-}
+    battle_ponder.p_context = new search_context;
+    battle_ponder.p_context->position = battle_position;
+    prepare_search_context(*battle_ponder.p_context, &battle_table, &battle_book, &battle_random_engine, &battle_tree);
+    battle_ponder.p_context->p_cancel_signal = &battle_ponder.cancel_signal;
+    battle_ponder.p_context->p_finish_signal = &battle_ponder.finish_signal;
+    // logs the search only if the player plays the predicted reply, since the search of a missed prediction is never played
+    battle_ponder.p_context->is_search_logged = false;
 
+    make_move(battle_ponder.p_context->position, predicted_move / 15, predicted_move % 15, 1);
 
-/*
-<Summary> :: assesses the value related to the top direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the top direction of the specified stone
-*/
-double assess_stone_top(int row, int column)
-{
-    double top_value {10.0};
-    int total_extendable_points {0};
+    // searches without a deadline, since the search is cancelled or finished when the player places a stone
+    battle_ponder.settings = battle_settings;
+    battle_ponder.settings.time_budget_milliseconds = 3600000;
 
-    for (int r {row - 1}; r >= 0 && gomoku_board[r][column] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r--);
+    battle_ponder.predicted_move = predicted_move;
+    battle_ponder.cancel_signal.store(false);
+    battle_ponder.finish_signal.store(false);
+    battle_ponder.is_running = true;
+    battle_ponder.thread = std::thread(ponder_player_reply);
 
-    if (total_extendable_points < 4)
-        top_value = 0.0;
-    else
-        for (int r {row - 1}; gomoku_board[r][column] == gomoku_board[row][column]; top_value *= 10.0, r--);
-
-    return top_value;
-}
-
-
-/*
-<Summary> :: assesses the value related to the bottom direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the bottom direction of the specified stone
-*/
-double assess_stone_bottom(int row, int column)
-{
-    double bottom_value {10.0};
-    int total_extendable_points {0};
-
-    for (int r {row + 1}; r <= 14 && gomoku_board[r][column] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r++);
-
-    if (total_extendable_points < 4)
-        bottom_value = 0.0;
-    else
-        for (int r {row + 1}; gomoku_board[r][column] == gomoku_board[row][column]; bottom_value *= 10.0, r++);
-
-    return bottom_value;
-}
-
-
-/*
-<Summary> :: assesses the value related to the left direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the left direction of the specified stone
-*/
-double assess_stone_left(int row, int column)
-{
-    double left_value {10.0};
-    int total_extendable_points {0};
-
-    for (int c {column - 1}; c >= 0 && gomoku_board[row][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, c--);
-
-    if (total_extendable_points < 4)
-        left_value = 0.0;
-    else
-        for (int c {column - 1}; gomoku_board[row][c] == gomoku_board[row][column]; left_value *= 10.0, c--);
-
-    return left_value;
-}
-
-
-/*
-<Summary> :: assesses the value related to the right direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the right direction of the specified stone
-*/
-double assess_stone_right(int row, int column)
-{
-    double right_value {10.0};
-    int total_extendable_points {0};
-
-    for (int c {column + 1}; c <= 14 && gomoku_board[row][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, c++);
-
-    if (total_extendable_points < 4)
-        right_value = 0.0;
-    else
-        for (int c {column + 1}; gomoku_board[row][c] == gomoku_board[row][column]; right_value *= 10.0, c++);
-
-    return right_value;
+    return;
 }
 
 
 /*
-<Summary> :: assesses the value related to the top left direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the top left direction of the specified stone
+<Summary> :: searches the AI's answer to the predicted player reply on the background thread
+<Parameters> :: none
+<Return> :: none
 */
-double assess_stone_top_left(int row, int column)
+void ponder_player_reply()
 {
-    double top_left_value {10.0};
-    int total_extendable_points {0};
-
-    for (int r {row - 1}, c {column - 1}; r >= 0 && c >= 0 && gomoku_board[r][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r--, c--);
-
-    if (total_extendable_points < 4)
-        top_left_value = 0.0;
-    else
-        for (int r {row - 1}, c {column - 1}; gomoku_board[r][c] == gomoku_board[row][column]; top_left_value *= 10.0, r--, c--);
+    battle_ponder.best_move = search_ai_move(*battle_ponder.p_context, battle_ponder.settings, battle_ponder.report);
 
-    return top_left_value;
+    return;
 }
 
 
 /*
-<Summary> :: assesses the value related to the top right direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the top right direction of the specified stone
+<Summary> :: cancels the background search at once and waits for its thread to end, which is used when the player does not play the predicted reply
+<Parameters> :: none
+<Return> :: none
 */
-double assess_stone_top_right(int row, int column)
+void cancel_pondering()
 {
-    double top_right_value {10.0};
-    int total_extendable_points {0};
+    if (!battle_ponder.is_running)
+        return;
 
-    for (int r {row - 1}, c {column + 1}; r >= 0 && c <= 14 && gomoku_board[r][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r--, c++);
+    battle_ponder.cancel_signal.store(true);
+    battle_ponder.thread.join();
 
-    if (total_extendable_points < 4)
-        top_right_value = 0.0;
-    else
-        for (int r {row - 1}, c {column + 1}; gomoku_board[r][c] == gomoku_board[row][column]; top_right_value *= 10.0, r--, c++);
+    delete battle_ponder.p_context;
+    battle_ponder.is_running = false;
 
-    return top_right_value;
+    return;
 }
 
 
 /*
-<Summary> :: assesses the value related to the bottom left direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the bottom left direction of the specified stone
+<Summary> :: ends the background search of the predicted player reply after its current iteration, and takes the move of the last completed iteration
+<Parameter "ref_best_move"> :: a reference to the variable storing the AI's best move, encoded as (row * 15 + column)
+<Return> :: whether the pondering provides the AI's move, which is false if nothing is pondered or the search has found no move
 */
-double assess_stone_bottom_left(int row, int column)
+bool finish_pondering(int &ref_best_move)
 {
-    double bottom_left_value {10.0};
-    int total_extendable_points {0};
-
-    for (int r {row + 1}, c {column - 1}; r <= 14 && c >= 0 && gomoku_board[r][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r++, c--);
+    bool is_move_found;
 
-    if (total_extendable_points < 4)
-        bottom_left_value = 0.0;
-    else
-        for (int r {row + 1}, c {column - 1}; gomoku_board[r][c] == gomoku_board[row][column]; bottom_left_value *= 10.0, r++, c--);
-
-    return bottom_left_value;
-}
+    if (!battle_ponder.is_running)
+        return false;
 
+    // the AI replies at once if an iteration has completed, and otherwise only lets the search complete its first iteration
+    battle_ponder.finish_signal.store(true);
+    battle_ponder.thread.join();
 
-/*
-<Summary> :: assesses the value related to the bottom right direction of a specified stone
-<Parameter "row"> :: the row index of a stone
-<Parameter "column"> :: the column index of a stone
-<Return> :: the value related to the bottom right direction of the specified stone
-*/
-double assess_stone_bottom_right(int row, int column)
-{
-    double bottom_right_value {10.0};
-    int total_extendable_points {0};
+    is_move_found = battle_ponder.best_move != -1 && (battle_ponder.report.is_book_move || battle_ponder.report.is_forced_win || battle_ponder.report.completed_depth > 0);
+    if (is_move_found)
+    {
+        ref_best_move = battle_ponder.best_move;
+        last_search_report = battle_ponder.report;
 
-    for (int r {row + 1}, c {column + 1}; r <= 14 && c <= 14 && gomoku_board[r][c] != -gomoku_board[row][column] && total_extendable_points < 4; total_extendable_points++, r++, c++);
+        write_search_log(battle_ponder.settings, battle_ponder.p_context->position, battle_ponder.best_move, battle_ponder.report);
+    }
 
-    if (total_extendable_points < 4)
-        bottom_right_value = 0.0;
-    else
-        for (int r {row + 1}, c {column + 1}; gomoku_board[r][c] == gomoku_board[row][column]; bottom_right_value *= 10.0, r++, c++);
+    delete battle_ponder.p_context;
+    battle_ponder.is_running = false;
 
-    return bottom_right_value;
+    return is_move_found;
 }
 
 
@@ -1556,14 +1304,16 @@ int end_battle(bool &ref_is_game_running)
 */
 int check_winner()
 {
-    int last_moved_player {gomoku_board[last_placed_row][last_placed_column]};
+    int last_placed_row {battle_position.last_placed_row};
+    int last_placed_column {battle_position.last_placed_column};
+    int last_moved_player {get_stone(battle_position, last_placed_row, last_placed_column)};
 
     // highlights the line of stones if the player of the last move forms an unbroken line of five stones vertically, and returns the winner
     for (int total_adjacent_stones {0}, offset {-4}; offset < 5; offset++)
     {
         if (last_placed_row + offset >= 0 && last_placed_row + offset <= 14)
         {
-            if (gomoku_board[last_placed_row + offset][last_placed_column] == last_moved_player)
+            if (get_stone(battle_position, last_placed_row + offset, last_placed_column) == last_moved_player)
                 total_adjacent_stones++;
             else
                 total_adjacent_stones = 0;
@@ -1581,7 +1331,7 @@ int check_winner()
     {
         if (last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
         {
-            if (gomoku_board[last_placed_row][last_placed_column + offset] == last_moved_player)
+            if (get_stone(battle_position, last_placed_row, last_placed_column + offset) == last_moved_player)
                 total_adjacent_stones++;
             else
                 total_adjacent_stones = 0;
@@ -1599,7 +1349,7 @@ int check_winner()
     {
         if (last_placed_row + offset >= 0 && last_placed_row + offset <= 14 && last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
         {
-            if (gomoku_board[last_placed_row + offset][last_placed_column + offset] == last_moved_player)
+            if (get_stone(battle_position, last_placed_row + offset, last_placed_column + offset) == last_moved_player)
                 total_adjacent_stones++;
             else
                 total_adjacent_stones = 0;
@@ -1617,7 +1367,7 @@ int check_winner()
     {
         if (last_placed_row - offset >= 0 && last_placed_row - offset <= 14 && last_placed_column + offset >= 0 && last_placed_column + offset <= 14)
         {
-            if (gomoku_board[last_placed_row - offset][last_placed_column + offset] == last_moved_player)
+            if (get_stone(battle_position, last_placed_row - offset, last_placed_column + offset) == last_moved_player)
                 total_adjacent_stones++;
             else
                 total_adjacent_stones = 0;
@@ -1650,7 +1400,7 @@ void highlight_winner_vertical(int end_row, int end_column)
         move_cursor(line_of_stone, column_of_stone);
 
         // displays a brighter and different stone with a virtual terminal sequence to highlight the winning line
-        if (gomoku_board[end_row][end_column] == 1)
+        if (get_stone(battle_position, end_row, end_column) == 1)
             std::cout << "\x1B[97m@\x1B[0m";
         else
             std::cout << "\x1B[91m@\x1B[0m";
@@ -1676,7 +1426,7 @@ void highlight_winner_horizontal(int end_row, int end_column)
         move_cursor(line_of_stone, column_of_stone);
 
         // displays a brighter and different stone with a virtual terminal sequence to highlight the winning line
-        if (gomoku_board[end_row][end_column] == 1)
+        if (get_stone(battle_position, end_row, end_column) == 1)
             std::cout << "\x1B[97m@\x1B[0m";
         else
             std::cout << "\x1B[91m@\x1B[0m";
@@ -1702,7 +1452,7 @@ void highlight_winner_major_diagonal(int end_row, int end_column)
         move_cursor(line_of_stone, column_of_stone);
 
         // displays a brighter and different stone with a virtual terminal sequence to highlight the winning line
-        if (gomoku_board[end_row][end_column] == 1)
+        if (get_stone(battle_position, end_row, end_column) == 1)
             std::cout << "\x1B[97m@\x1B[0m";
         else
             std::cout << "\x1B[91m@\x1B[0m";
@@ -1728,7 +1478,7 @@ void highlight_winner_minor_diagonal(int end_row, int end_column)
         move_cursor(line_of_stone, column_of_stone);
 
         // displays a brighter and different stone with a virtual terminal sequence to highlight the winning line
-        if (gomoku_board[end_row][end_column] == 1)
+        if (get_stone(battle_position, end_row, end_column) == 1)
             std::cout << "\x1B[97m@\x1B[0m";
         else
             std::cout << "\x1B[91m@\x1B[0m";
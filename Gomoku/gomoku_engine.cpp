@@ -0,0 +1,3543 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+// includes the file mapping functions of the operating system to read the opening book
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "gomoku_engine.h"
+
+
+// the proof or disproof number of a decided position, which is larger than any sum of undecided numbers
+unsigned int infinite_proof_number {100000000};
+
+// the board values are integers, so that they compare exactly and give the same search on every compiler
+// a win is worth the win board value less the number of stones placed since the root, which prefers the fastest win and the slowest loss
+int win_board_value {1000000000};
+// the limit of the assessed board values, which keeps every undecided position below the value of the slowest win
+int max_assessed_value {500000000};
+// the bound beyond every board value, which opens the window of a search
+int infinite_board_value {1001000000};
+
+// the weight of the exploration term in the upper confidence bound of the Monte Carlo tree search, where the exploitation term is the win rate from 0 to 1
+double mcts_exploration_weight {0.7};
+
+// the random keys of each side's stone on each point, and the key of the player's turn, which are combined by XOR into the Zobrist key of a position
+unsigned long long zobrist_keys[2][15][15];
+unsigned long long zobrist_player_key;
+
+// the point that each point is moved to by each of the eight rotations and reflections of the board, both encoded as (row * 15 + column)
+unsigned char symmetric_points[8][225];
+
+
+// the value of a stone indexed by the line pattern around it, where each of the four points on both sides is encoded in two bits (0 = empty, 1 = own stone, 2 = opponent's stone, 3 = outside the board)
+// the lowest two bits encode the farthest point in the direction of lower bit positions, and the highest two bits encode the farthest point in the direction of higher bit positions
+int pattern_values[65536];
+
+// whether every line pattern has the value of its mirror image, which makes the evaluation the same under all eight rotations and reflections of the board
+// the search keys share one transposition entry among the symmetries of a position only if it is true, since a tuned table without mirror symmetry scores them differently
+bool is_pattern_symmetric {true};
+
+// the bits of every byte spread to the even bit positions, which interleaves the own and opponent windows of a line pattern into its index
+unsigned short interleaved_bits[256];
+
+
+/*
+<Summary> :: generates the random keys for Zobrist hashing, using a fixed seed so that the search keys are the same in every run, and the points of the board symmetries for the symmetric keys
+<Parameters> :: none
+<Return> :: none
+*/
+void initialize_zobrist_keys()
+{
+    std::mt19937_64 random_engine {20240101};
+
+    for (int side {0}; side < 2; side++)
+        for (int row {0}; row < 15; row++)
+            for (int column {0}; column < 15; column++)
+                zobrist_keys[side][row][column] = random_engine();
+
+    zobrist_player_key = random_engine();
+
+    for (int symmetry {0}; symmetry < 8; symmetry++)
+        for (int move {0}; move < 225; move++)
+            symmetric_points[symmetry][move] = static_cast<unsigned char>(transform_move(move, symmetry));
+
+    return;
+}
+
+
+/*
+<Summary> :: generates the value of every line pattern for the AI evaluation, and replaces them with tuned values if the file "pattern_values.txt" exists
+the tuned values are kept even if a pattern and its mirror image differ, but then the search keys fall back to the plain Zobrist key, since the symmetries of a position no longer share their values
+<Parameters> :: none
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int initialize_pattern_values()
+{
+    std::ifstream pattern_file;
+
+    for (int byte {0}; byte < 256; byte++)
+    {
+        interleaved_bits[byte] = 0;
+
+        for (int bit {0}; bit < 8; bit++)
+            interleaved_bits[byte] |= ((byte >> bit) & 1) << (bit * 2);
+    }
+
+    for (int pattern {0}; pattern < 65536; pattern++)
+    {
+        int points[9];
+
+        // decodes the four points on each side of the stone, and places the stone itself at the middle of the window
+        for (int point {0}, code {pattern}; point < 9; point++)
+        {
+            if (point == 4)
+            {
+                points[point] = 1;
+            }
+            else
+            {
+                points[point] = code & 3;
+                code >>= 2;
+            }
+        }
+
+        pattern_values[pattern] = assess_pattern_direction(points, 5, 1) + assess_pattern_direction(points, 3, -1);
+    }
+
+    // reads 65536 whitespace-separated values in the order of pattern indexes, and exits the current function if the file is incomplete
+    // the file keeps the scale of a stone's open direction worth 10, and each value is limited to 100000000 before it is scaled to the integer values
+    pattern_file.open("pattern_values.txt");
+    if (pattern_file.is_open())
+    {
+        for (int pattern {0}; pattern < 65536; pattern++)
+        {
+            double file_value;
+
+            if (!(pattern_file >> file_value))
+                return __LINE__;
+
+            pattern_values[pattern] = static_cast<int>(std::llround(std::min(std::max(file_value, -1e8), 1e8) * 10.0));
+        }
+    }
+
+    // compares every pattern with its mirror image, which reverses the order of its eight two-bit points
+    is_pattern_symmetric = true;
+
+    for (int pattern {0}; pattern < 65536 && is_pattern_symmetric; pattern++)
+    {
+        int mirrored_pattern {0};
+
+        for (int point {0}; point < 8; point++)
+            mirrored_pattern |= ((pattern >> (point * 2)) & 3) << ((7 - point) * 2);
+
+        is_pattern_symmetric = pattern_values[pattern] == pattern_values[mirrored_pattern];
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: assesses the value related to one direction of the stone at the middle of a line pattern
+<Parameter "points"> :: the nine points of the line pattern (0 = empty, 1 = own stone, 2 = opponent's stone, 3 = outside the board)
+<Parameter "first_point"> :: the index of the point next to the stone in the assessed direction
+<Parameter "step"> :: the index step towards the assessed direction (1 or -1)
+<Return> :: the value related to the specified direction of the stone
+*/
+int assess_pattern_direction(const int points[9], int first_point, int step)
+{
+    int direction_value {100};
+
+    // returns zero if the next four points contain any opponent's stone or any point outside the gomoku board
+    for (int offset {0}; offset < 4; offset++)
+        if (points[first_point + offset * step] >= 2)
+            return 0;
+
+    for (int offset {0}; offset < 4 && points[first_point + offset * step] == 1; direction_value *= 10, offset++);
+
+    return direction_value;
+}
+
+
+/*
+<Summary> :: prepares a search context for the search of its position, which sets the tables that the search uses, leaves the search without a cancel or finish signal, and lets it write the search log
+<Parameter "ref_context"> :: a reference to the search context, whose position is set by the caller
+<Parameter "p_table"> :: a pointer to the transposition table shared by the search threads
+<Parameter "p_book"> :: a pointer to the opening book consulted before searching, or nullptr to search without a book
+<Parameter "p_random_engine"> :: a pointer to the random engine picking among the book replies, or nullptr to always play the heaviest reply
+<Parameter "p_tree"> :: a pointer to the tree of the Monte Carlo tree search, or nullptr to always search with the alpha-beta search
+<Return> :: none
+*/
+void prepare_search_context(search_context &ref_context, transposition_table *p_table, const opening_book *p_book, std::mt19937 *p_random_engine, mcts_tree *p_tree)
+{
+    ref_context.p_table = p_table;
+    ref_context.p_book = p_book;
+    ref_context.p_random_engine = p_random_engine;
+    ref_context.p_tree = p_tree;
+    ref_context.p_cancel_signal = nullptr;
+    ref_context.p_finish_signal = nullptr;
+    ref_context.is_search_logged = true;
+
+    return;
+}
+
+
+/*
+<Summary> :: fills the report of an AI move that is played without a search, which has no depth, nodes, or counters
+<Parameter "ref_report"> :: a reference to the report, whose flag of a book move is kept
+<Return> :: none
+*/
+void clear_search_report(search_report &ref_report)
+{
+    ref_report.is_forced_win = false;
+    ref_report.completed_depth = 0;
+    ref_report.total_nodes = 0;
+    ref_report.total_threads = 1;
+    ref_report.elapsed_milliseconds = 0;
+    ref_report.nodes_per_second = 0;
+    ref_report.board_value = 0;
+    ref_report.first_move_cutoff_rate = 0.0;
+    ref_report.vcf_nodes = 0;
+    ref_report.table_hit_rate = 0.0;
+    ref_report.counters = search_counters {};
+    ref_report.win_rate = 0.0;
+
+    return;
+}
+
+
+/*
+<Summary> :: searches the AI's best move on the main thread and the helper threads of the AI settings, which share the transposition table of the search context (Lazy SMP)
+<Parameter "ref_context"> :: a reference to the search context of the main thread, whose position has the AI to move
+<Parameter "ref_settings"> :: a reference to the settings containing the time, node, depth, and thread budgets
+<Parameter "ref_report"> :: a reference to the structure storing the reached depth and other results of the search
+<Return> :: the best move of the deepest completed iteration among the threads, encoded as (row * 15 + column), or -1 if the board is empty or full, which leaves the first move and the tie to the caller
+*/
+int search_ai_move(search_context &ref_context, const search_settings &ref_settings, search_report &ref_report)
+{
+    std::atomic<bool> stop_signal {false};
+    std::atomic<long long> shared_nodes {0};
+    int total_threads {ref_settings.total_threads > 0 ? ref_settings.total_threads : static_cast<int>(std::thread::hardware_concurrency())};
+    std::vector<search_context> helper_contexts;
+    std::vector<std::thread> helper_threads;
+    search_context *p_chosen_context {&ref_context};
+    long long total_cutoffs {0};
+
+    // uses one thread if the number of hardware threads is unknown
+    if (total_threads < 1)
+        total_threads = 1;
+
+    ref_context.start_time = std::chrono::steady_clock::now();
+    ref_context.deadline = ref_context.start_time + std::chrono::milliseconds(ref_settings.time_budget_milliseconds);
+    ref_context.p_stop_signal = &stop_signal;
+    ref_context.total_split_threads = ref_settings.is_root_split ? total_threads : 0;
+    ref_context.is_principal_variation_search = ref_settings.is_principal_variation_search;
+    // the root split searches without late move reductions and futility pruning, since both depend on alpha, which comes from the best value that the threads share in the order they finish
+    // the move of the root split would otherwise depend on the thread count and timing
+    ref_context.is_late_move_reduction_enabled = ref_settings.is_late_move_reduction_enabled && !ref_settings.is_root_split;
+    ref_context.futility_margin = ref_settings.is_root_split ? 0 : ref_settings.futility_margin;
+    ref_context.max_quiescence_depth = ref_settings.max_quiescence_depth;
+    ref_context.node_budget = ref_settings.node_budget;
+    ref_context.total_nodes = 0;
+    ref_context.p_shared_nodes = &shared_nodes;
+    ref_context.shared_counted_nodes = 0;
+    ref_context.completed_depth = 0;
+    ref_context.is_aborted = false;
+    ref_context.root_total_stones = ref_context.position.total_stones;
+    ref_context.counters = search_counters {};
+    ref_context.is_timed = ref_settings.p_search_log_path != nullptr;
+    ref_context.vcf_nodes = 0;
+
+    // plays a reply from the opening book at once, which saves the whole search in the first moves of a battle
+    ref_report.is_book_move = ref_context.p_book != nullptr && ref_context.position.total_stones < ref_settings.max_book_stones && find_book_move(*ref_context.p_book, ref_context.position, ref_context.p_random_engine, ref_context.best_move);
+    if (ref_report.is_book_move)
+    {
+        clear_search_report(ref_report);
+
+        if (ref_context.is_search_logged)
+            write_search_log(ref_settings, ref_context.position, ref_context.best_move, ref_report);
+
+        return ref_context.best_move;
+    }
+
+    for (int ply {0}; ply < 225; ply++)
+    {
+        ref_context.killer_moves[ply][0] = -1;
+        ref_context.killer_moves[ply][1] = -1;
+    }
+
+    for (int side {0}; side < 2; side++)
+        for (int move {0}; move < 225; move++)
+            ref_context.history_scores[side][move] = 0;
+
+    // starts a new generation so that the entries of earlier moves are replaced first
+    ref_context.p_table->generation++;
+
+    // returns no move if the board has no candidate move, which happens only if it is empty or full
+    ref_context.total_root_moves = generate_candidate_moves(ref_context.position, ref_context.root_moves);
+    if (ref_context.total_root_moves == 0)
+    {
+        clear_search_report(ref_report);
+        ref_context.best_move = -1;
+
+        return -1;
+    }
+
+    // falls back to the first candidate move, although the first iteration always completes
+    ref_context.best_move = ref_context.root_moves[0];
+    ref_context.best_value = 0;
+    ref_report.win_rate = 0.0;
+
+    // plays a forced win at once, since the continuous-four solver sees much deeper than the full-width search
+    ref_report.is_forced_win = solve_vcf(ref_context, 1, ref_settings, ref_context.best_move);
+
+    if (!ref_report.is_forced_win && ref_settings.is_monte_carlo_search && ref_context.p_tree != nullptr)
+    {
+        ref_context.total_root_moves = filter_vcf_defenses(ref_context, ref_settings);
+
+        // gives every helper thread a copy of the search context, and counts their playouts in the report
+        helper_contexts.assign(total_threads > 1 ? total_threads - 1 : 0, ref_context);
+
+        search_monte_carlo(ref_context, ref_settings, *ref_context.p_tree, helper_contexts, stop_signal, ref_report.win_rate);
+    }
+    else if (!ref_report.is_forced_win)
+    {
+        ref_context.total_root_moves = filter_vcf_defenses(ref_context, ref_settings);
+
+        // gives every helper thread its own copy of the position and move ordering tables, and starts half of them one move deeper
+        // the threads only share the transposition table, where each thread finds the results of the others in a different order
+        helper_contexts.assign(total_threads > 1 && !ref_settings.is_root_split ? total_threads - 1 : 0, ref_context);
+
+        for (int index {0}; index < static_cast<int>(helper_contexts.size()); index++)
+            helper_threads.emplace_back(deepen_search, std::ref(helper_contexts[index]), std::cref(ref_settings), 1 + (index + 1) % 2, false);
+
+        deepen_search(ref_context, ref_settings, 1, true);
+
+        // stops the helper threads as soon as the main thread has its result
+        stop_signal.store(true, std::memory_order_relaxed);
+
+        for (std::thread &ref_thread : helper_threads)
+            ref_thread.join();
+    }
+
+    ref_report.total_nodes = ref_context.total_nodes;
+    ref_report.counters = ref_context.counters;
+
+    // picks the deepest completed iteration, and prefers the main thread if the depths are equal
+    for (search_context &ref_helper_context : helper_contexts)
+    {
+        if (ref_helper_context.completed_depth > p_chosen_context->completed_depth)
+            p_chosen_context = &ref_helper_context;
+
+        ref_report.total_nodes += ref_helper_context.total_nodes;
+        merge_search_counters(ref_report.counters, ref_helper_context.counters, search_counters {});
+    }
+
+    ref_report.completed_depth = p_chosen_context->completed_depth;
+    ref_report.board_value = p_chosen_context->best_value;
+    ref_report.total_threads = ref_settings.is_root_split ? ref_context.total_split_threads : static_cast<int>(helper_contexts.size()) + 1;
+    ref_report.elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - ref_context.start_time).count();
+    ref_report.nodes_per_second = ref_report.total_nodes * 1000 / (ref_report.elapsed_milliseconds > 0 ? ref_report.elapsed_milliseconds : 1);
+    ref_report.vcf_nodes = ref_context.vcf_nodes;
+    ref_report.table_hit_rate = ref_report.counters.table_probes > 0 ? static_cast<double>(ref_report.counters.table_hits) / ref_report.counters.table_probes : 0.0;
+
+    for (long long cutoffs : ref_report.counters.cutoffs_by_index)
+        total_cutoffs += cutoffs;
+
+    ref_report.first_move_cutoff_rate = total_cutoffs > 0 ? static_cast<double>(ref_report.counters.cutoffs_by_index[0]) / total_cutoffs : 0.0;
+
+    if (ref_context.is_search_logged)
+        write_search_log(ref_settings, ref_context.position, p_chosen_context->best_move, ref_report);
+
+    return p_chosen_context->best_move;
+}
+
+
+/*
+<Summary> :: searches the AI's best move using iterative deepening, which repeats the minimax search one move deeper each time until the budget runs out, and stores the result of the last completed iteration to the search context
+each iteration after the first starts with an aspiration window around the value of the previous iteration if the settings enable it
+<Parameter "ref_context"> :: a reference to the search context, whose root moves have been generated
+<Parameter "ref_settings"> :: a reference to the settings containing the time and depth budgets
+<Parameter "first_depth"> :: the depth of the first iteration, which differs between search threads so that they do not repeat the same work
+<Parameter "is_main_thread"> :: whether the search runs on the main thread, which stops early when the next iteration is unlikely to finish
+<Return> :: none
+*/
+void deepen_search(search_context &ref_context, const search_settings &ref_settings, int first_depth, bool is_main_thread)
+{
+    for (int search_depth {first_depth}; search_depth <= ref_settings.max_search_depth && search_depth <= 225 - ref_context.position.total_stones; search_depth++)
+    {
+        int iteration_move;
+        int iteration_value;
+        int max_board_value {-infinite_board_value};
+        int min_board_value {infinite_board_value};
+        std::chrono::steady_clock::duration elapsed_time;
+
+        if (ref_settings.aspiration_window > 0 && ref_context.completed_depth > 0)
+        {
+            max_board_value = ref_context.best_value - ref_settings.aspiration_window;
+            min_board_value = ref_context.best_value + ref_settings.aspiration_window;
+        }
+
+        search_root_moves(ref_context, search_depth, max_board_value, min_board_value, iteration_move, iteration_value);
+
+        // searches again with the failing end of the window opened, since a value outside the aspiration window is only a bound of the true value
+        while (!ref_context.is_aborted && (iteration_value <= max_board_value || iteration_value >= min_board_value))
+        {
+            if (iteration_value <= max_board_value)
+                max_board_value = -infinite_board_value;
+            else
+                min_board_value = infinite_board_value;
+
+            search_root_moves(ref_context, search_depth, max_board_value, min_board_value, iteration_move, iteration_value);
+        }
+
+        // discards the unfinished iteration, and keeps the result of the last completed one
+        if (ref_context.is_aborted)
+            break;
+
+        ref_context.best_move = iteration_move;
+        ref_context.best_value = iteration_value;
+        ref_context.completed_depth = search_depth;
+
+        // skips the next iteration if more than half of the time budget has been spent, since a deeper search takes several times longer
+        elapsed_time = std::chrono::steady_clock::now() - ref_context.start_time;
+        if (is_main_thread && elapsed_time * 2 > std::chrono::milliseconds(ref_settings.time_budget_milliseconds))
+            break;
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: searches every root move of the AI to a specified depth using the minimax algorithm with alpha-beta pruning
+<Parameter "ref_context"> :: a reference to the search context
+<Parameter "search_depth"> :: the number of moves to be predicted, including the AI's next move
+<Parameter "max_board_value"> :: the lower end of the window, below which the board values are only upper bounds
+<Parameter "min_board_value"> :: the upper end of the window, above which the board values are only lower bounds
+<Parameter "ref_best_move"> :: a reference to the variable storing the best move, encoded as (row * 15 + column)
+<Parameter "ref_best_value"> :: a reference to the variable storing the predicted board value of the best move, which is the lower end of the window if every move fails low
+<Return> :: none
+*/
+void search_root_moves(search_context &ref_context, int search_depth, int max_board_value, int min_board_value, int &ref_best_move, int &ref_best_value)
+{
+    bitboard_position &ref_position {ref_context.position};
+    int original_max_board_value {max_board_value};
+    int symmetry;
+    unsigned long long search_key {get_search_key(ref_position, false, symmetry)};
+    int moves[225];
+    int total_moves;
+    int best_move;
+    int stored_value;
+
+    // searches the best move of the previous iteration first, since it is likely to remain the best move, and orders the other moves by their scores
+    probe_transposition_table(*ref_context.p_table, search_key, symmetry, 0, search_depth, ref_context.total_split_threads > 0, max_board_value, min_board_value, stored_value, best_move);
+
+    total_moves = ref_context.total_root_moves;
+    std::copy(ref_context.root_moves, ref_context.root_moves + total_moves, moves);
+    order_candidate_moves(ref_context, moves, total_moves, 1, best_move);
+
+    ref_best_move = moves[0];
+
+    if (ref_context.total_split_threads > 0)
+    {
+        split_root_moves(ref_context, search_depth, moves, total_moves, max_board_value, ref_best_move, max_board_value);
+
+        if (ref_context.is_aborted)
+            return;
+    }
+
+    for (int index {0}; ref_context.total_split_threads == 0 && index < total_moves; index++)
+    {
+        int row {moves[index] / 15};
+        int column {moves[index] % 15};
+        int board_value;
+
+        make_move(ref_position, row, column, -1);
+
+        // proves with a null window that a later move is no better than the best move, and searches it again with the full window only if it is better
+        if (!ref_context.is_principal_variation_search)
+        {
+            board_value = predict_board_value(ref_context, true, search_depth - 1, max_board_value, min_board_value);
+        }
+        else if (index == 0)
+        {
+            board_value = -search_principal_variation(ref_context, true, search_depth - 1, -min_board_value, -max_board_value);
+        }
+        else
+        {
+            board_value = -search_principal_variation(ref_context, true, search_depth - 1, -max_board_value - 1, -max_board_value);
+
+            if (board_value > max_board_value && board_value < min_board_value)
+                board_value = -search_principal_variation(ref_context, true, search_depth - 1, -min_board_value, -max_board_value);
+        }
+
+        unmake_move(ref_position);
+
+        if (ref_context.is_aborted)
+            return;
+
+        if (board_value > max_board_value)
+        {
+            max_board_value = board_value;
+            ref_best_move = moves[index];
+        }
+
+        // stops at a move reaching the upper end of the window, which makes the iteration search again with a wider window
+        if (max_board_value >= min_board_value)
+            break;
+    }
+
+    ref_best_value = max_board_value;
+    store_transposition_table(*ref_context.p_table, search_key, symmetry, 0, search_depth, max_board_value, original_max_board_value, min_board_value, ref_best_move);
+
+    return;
+}
+
+
+/*
+<Summary> :: searches the ordered root moves on a pool of threads, where each thread takes the next unsearched move and all threads prune against a shared maximum board value
+<Parameter "ref_context"> :: a reference to the search context of the main thread, which joins the pool as its first worker
+<Parameter "search_depth"> :: the number of moves to be predicted, including the AI's next move
+<Parameter "moves"> :: an array storing the ordered root moves
+<Parameter "total_moves"> :: the number of root moves
+<Parameter "max_board_value"> :: the lower end of the window, which the shared maximum board value starts from, while the upper end is always open
+<Parameter "ref_best_move"> :: a reference to the variable storing the best move, encoded as (row * 15 + column)
+<Parameter "ref_best_value"> :: a reference to the variable storing the predicted board value of the best move
+<Return> :: none
+*/
+void split_root_moves(search_context &ref_context, int search_depth, const int moves[], int total_moves, int max_board_value, int &ref_best_move, int &ref_best_value)
+{
+    root_split split;
+    std::vector<search_context> worker_contexts;
+    std::vector<std::thread> worker_threads;
+    long long start_nodes {ref_context.total_nodes};
+    search_counters start_counters {ref_context.counters};
+
+    // counts the nodes of the main thread before the workers copy its context, so that each worker only adds its own nodes to the shared count
+    count_shared_nodes(ref_context);
+    worker_contexts.assign(ref_context.total_split_threads, ref_context);
+
+    split.p_moves = moves;
+    split.total_moves = total_moves;
+    split.next_index.store(0);
+    split.max_board_value.store(max_board_value);
+
+    for (int index {1}; index < ref_context.total_split_threads; index++)
+        worker_threads.emplace_back(search_split_moves, std::ref(worker_contexts[index]), std::ref(split), search_depth);
+
+    search_split_moves(worker_contexts[0], split, search_depth);
+
+    for (std::thread &ref_thread : worker_threads)
+        ref_thread.join();
+
+    for (const search_context &ref_worker_context : worker_contexts)
+    {
+        ref_context.total_nodes += ref_worker_context.total_nodes - start_nodes;
+        ref_context.shared_counted_nodes += ref_worker_context.shared_counted_nodes - start_nodes;
+        merge_search_counters(ref_context.counters, ref_worker_context.counters, start_counters);
+
+        if (ref_worker_context.is_aborted)
+            ref_context.is_aborted = true;
+    }
+
+    if (ref_context.is_aborted)
+        return;
+
+    // picks the highest board value, and the lowest move among equal values, so that the result does not depend on which thread searched which move
+    // a move failing low returns a value below the shared maximum at that time, so it can never equal the best value
+    ref_best_move = moves[0];
+    ref_best_value = split.move_values[0];
+
+    for (int index {1}; index < total_moves; index++)
+    {
+        if (split.move_values[index] > ref_best_value || (split.move_values[index] == ref_best_value && moves[index] < ref_best_move))
+        {
+            ref_best_move = moves[index];
+            ref_best_value = split.move_values[index];
+        }
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: searches root moves taken from a shared root split until none is left, and raises the shared maximum board value with the results
+<Parameter "ref_context"> :: a reference to the search context of the worker, which holds its own copy of the position
+<Parameter "ref_split"> :: a reference to the root split shared by the workers
+<Parameter "search_depth"> :: the number of moves to be predicted, including the AI's next move
+<Return> :: none
+*/
+void search_split_moves(search_context &ref_context, root_split &ref_split, int search_depth)
+{
+    bitboard_position &ref_position {ref_context.position};
+    int index;
+
+    while ((index = ref_split.next_index.fetch_add(1)) < ref_split.total_moves)
+    {
+        int row {ref_split.p_moves[index] / 15};
+        int column {ref_split.p_moves[index] % 15};
+        int max_board_value {ref_split.max_board_value.load()};
+        int board_value;
+
+        // lowers the window by one, so that a move equal to the shared maximum still gets its exact value for the tie-break
+        if (max_board_value != -infinite_board_value)
+            max_board_value--;
+
+        make_move(ref_position, row, column, -1);
+
+        if (ref_context.is_principal_variation_search)
+            board_value = -search_principal_variation(ref_context, true, search_depth - 1, -infinite_board_value, -max_board_value);
+        else
+            board_value = predict_board_value(ref_context, true, search_depth - 1, max_board_value, infinite_board_value);
+
+        unmake_move(ref_position);
+
+        if (ref_context.is_aborted)
+            return;
+
+        ref_split.move_values[index] = board_value;
+
+        // raises the shared maximum unless another worker has raised it higher in the meantime
+        for (int shared_value {ref_split.max_board_value.load()}; board_value > shared_value && !ref_split.max_board_value.compare_exchange_weak(shared_value, board_value););
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: aborts the search if the main thread has stopped the helper threads or the caller has cancelled the search, or if the deadline has passed, the node budget has been used up, or the caller has finished the search except during the first iteration
+the node budget limits the nodes of all threads, which each thread adds to the shared count at every check
+<Parameter "ref_context"> :: a reference to the search context
+<Return> :: none
+*/
+void check_search_limits(search_context &ref_context)
+{
+    long long shared_nodes {count_shared_nodes(ref_context)};
+
+    if ((ref_context.p_stop_signal != nullptr && ref_context.p_stop_signal->load(std::memory_order_relaxed)) || (ref_context.p_cancel_signal != nullptr && ref_context.p_cancel_signal->load(std::memory_order_relaxed)))
+    {
+        ref_context.is_aborted = true;
+        return;
+    }
+
+    if (ref_context.completed_depth == 0)
+        return;
+
+    if (std::chrono::steady_clock::now() >= ref_context.deadline)
+        ref_context.is_aborted = true;
+
+    if (ref_context.node_budget > 0 && shared_nodes >= ref_context.node_budget)
+        ref_context.is_aborted = true;
+
+    if (ref_context.p_finish_signal != nullptr && ref_context.p_finish_signal->load(std::memory_order_relaxed))
+        ref_context.is_aborted = true;
+
+    return;
+}
+
+
+/*
+<Summary> :: adds the nodes that a search context has searched since its last count to the nodes shared by all threads of the search
+<Parameter "ref_context"> :: a reference to the search context
+<Return> :: the nodes searched by all threads so far, or the nodes of the context if it has no shared count
+*/
+long long count_shared_nodes(search_context &ref_context)
+{
+    long long new_nodes {ref_context.total_nodes - ref_context.shared_counted_nodes};
+
+    if (ref_context.p_shared_nodes == nullptr)
+        return ref_context.total_nodes;
+
+    ref_context.shared_counted_nodes = ref_context.total_nodes;
+
+    return ref_context.p_shared_nodes->fetch_add(new_nodes, std::memory_order_relaxed) + new_nodes;
+}
+
+
+/*
+<Summary> :: adds the counters that a thread has gathered since it started from a copy of other counters
+<Parameter "ref_counters"> :: a reference to the counters to be added to
+<Parameter "ref_thread_counters"> :: a reference to the counters of the thread
+<Parameter "ref_start_counters"> :: a reference to the counters that the thread started from, which are already included in the counters to be added to
+<Return> :: none
+*/
+void merge_search_counters(search_counters &ref_counters, const search_counters &ref_thread_counters, const search_counters &ref_start_counters)
+{
+    ref_counters.leaf_evaluations += ref_thread_counters.leaf_evaluations - ref_start_counters.leaf_evaluations;
+    ref_counters.battle_state_checks += ref_thread_counters.battle_state_checks - ref_start_counters.battle_state_checks;
+    ref_counters.table_probes += ref_thread_counters.table_probes - ref_start_counters.table_probes;
+    ref_counters.table_hits += ref_thread_counters.table_hits - ref_start_counters.table_hits;
+
+    for (int index {0}; index < 8; index++)
+        ref_counters.cutoffs_by_index[index] += ref_thread_counters.cutoffs_by_index[index] - ref_start_counters.cutoffs_by_index[index];
+
+    ref_counters.reduced_moves += ref_thread_counters.reduced_moves - ref_start_counters.reduced_moves;
+    ref_counters.reduction_researches += ref_thread_counters.reduction_researches - ref_start_counters.reduction_researches;
+    ref_counters.futility_prunes += ref_thread_counters.futility_prunes - ref_start_counters.futility_prunes;
+    ref_counters.quiescence_nodes += ref_thread_counters.quiescence_nodes - ref_start_counters.quiescence_nodes;
+
+    ref_counters.move_generation_nanoseconds += ref_thread_counters.move_generation_nanoseconds - ref_start_counters.move_generation_nanoseconds;
+    ref_counters.stone_update_nanoseconds += ref_thread_counters.stone_update_nanoseconds - ref_start_counters.stone_update_nanoseconds;
+    ref_counters.evaluation_nanoseconds += ref_thread_counters.evaluation_nanoseconds - ref_start_counters.evaluation_nanoseconds;
+
+    return;
+}
+
+
+/*
+<Summary> :: appends the results and counters of an AI move to the search log as one line of "key=value" items, where the times are in milliseconds summed over all threads
+<Parameter "ref_settings"> :: a reference to the settings containing the path of the search log
+<Parameter "ref_position"> :: a reference to the searched position
+<Parameter "best_move"> :: the AI's move, encoded as (row * 15 + column)
+<Parameter "ref_report"> :: a reference to the report of the search
+<Return> :: none
+*/
+void write_search_log(const search_settings &ref_settings, const bitboard_position &ref_position, int best_move, const search_report &ref_report)
+{
+    std::ofstream log_file;
+    std::ostream *p_log_stream {&std::cerr};
+    const search_counters &ref_counters {ref_report.counters};
+
+    if (ref_settings.p_search_log_path == nullptr)
+        return;
+
+    // leaves the search unlogged if the log file cannot be opened, since the log must never stop the AI from moving
+    if (std::string {ref_settings.p_search_log_path} != "-")
+    {
+        log_file.open(ref_settings.p_search_log_path, std::ios::app);
+        if (!log_file)
+            return;
+
+        p_log_stream = &log_file;
+    }
+
+    *p_log_stream << "search stones=" << ref_position.total_stones << " move=" << best_move / 15 << ',' << best_move % 15 << " depth=" << ref_report.completed_depth << " value=" << ref_report.board_value;
+    *p_log_stream << " book=" << ref_report.is_book_move << " forced_win=" << ref_report.is_forced_win << " threads=" << ref_report.total_threads << " elapsed_ms=" << ref_report.elapsed_milliseconds;
+    *p_log_stream << " nodes=" << ref_report.total_nodes << " vcf_nodes=" << ref_report.vcf_nodes << " nodes_per_second=" << ref_report.nodes_per_second;
+    *p_log_stream << " leaf_evaluations=" << ref_counters.leaf_evaluations << " battle_state_checks=" << ref_counters.battle_state_checks << " table_probes=" << ref_counters.table_probes << " table_hits=" << ref_counters.table_hits;
+    *p_log_stream << " cutoffs_by_index=";
+
+    for (int index {0}; index < 8; index++)
+        *p_log_stream << (index > 0 ? "," : "") << ref_counters.cutoffs_by_index[index];
+
+    *p_log_stream << " reduced_moves=" << ref_counters.reduced_moves << " reduction_researches=" << ref_counters.reduction_researches << " futility_prunes=" << ref_counters.futility_prunes << " quiescence_nodes=" << ref_counters.quiescence_nodes << " win_rate=" << ref_report.win_rate;
+
+    *p_log_stream << " move_generation_ms=" << ref_counters.move_generation_nanoseconds / 1000000.0 << " stone_update_ms=" << ref_counters.stone_update_nanoseconds / 1000000.0 << " evaluation_ms=" << ref_counters.evaluation_nanoseconds / 1000000.0 << std::endl;
+
+    return;
+}
+
+
+/*
+<Summary> :: keeps only the root moves of the AI that stop a forced win of the player, since the other moves lose to a continuous-four sequence
+the checks of all root moves share one node budget of the solver, and stop at the deadline or on cancellation
+<Parameter "ref_context"> :: a reference to the search context, whose root moves are filtered
+<Parameter "ref_settings"> :: a reference to the settings containing the depth and node budgets of the solver
+<Return> :: the number of remaining root moves, which are all the root moves if the player has no forced win, no move can stop it, or the checks stop early
+*/
+int filter_vcf_defenses(search_context &ref_context, const search_settings &ref_settings)
+{
+    int defenses[225];
+    int total_defenses {0};
+    int threat_move;
+
+    if (!solve_vcf(ref_context, 0, ref_settings, threat_move))
+        return ref_context.total_root_moves;
+
+    // gives the checks one budget for the whole move, since a separate budget for each of up to 225 root moves could take seconds
+    ref_context.vcf_node_limit = ref_context.vcf_nodes + ref_settings.vcf_node_budget;
+
+    for (int index {0}; index < ref_context.total_root_moves; index++)
+    {
+        int move {ref_context.root_moves[index]};
+        bool is_defended;
+
+        make_move(ref_context.position, move / 15, move % 15, -1);
+        is_defended = !search_vcf(ref_context, 0, ref_settings.max_vcf_depth, threat_move);
+        unmake_move(ref_context.position);
+
+        // keeps every root move unchanged if the budget runs out, since a check that gives up cannot tell a defense from a loss
+        if (is_defended && ref_context.vcf_nodes >= ref_context.vcf_node_limit)
+            return ref_context.total_root_moves;
+
+        if (is_defended)
+            defenses[total_defenses++] = move;
+    }
+
+    // leaves the choice to the full-width search if the forced win cannot be stopped
+    if (total_defenses == 0)
+        return ref_context.total_root_moves;
+
+    for (int index {0}; index < total_defenses; index++)
+        ref_context.root_moves[index] = defenses[index];
+
+    return total_defenses;
+}
+
+
+/*
+<Summary> :: solves whether a side can win by a continuous-four sequence (VCF), in which every move of the side makes a four that the opponent must block
+<Parameter "ref_context"> :: a reference to the search context, whose position is solved as if the specified side moves next
+<Parameter "side"> :: the attacking side (0 = player, 1 = AI)
+<Parameter "ref_settings"> :: a reference to the settings containing the depth and node budgets of the solver
+<Parameter "ref_winning_move"> :: a reference to the variable storing the first move of the winning sequence, encoded as (row * 15 + column)
+<Return> :: whether a winning sequence is found within the budgets
+*/
+bool solve_vcf(search_context &ref_context, int side, const search_settings &ref_settings, int &ref_winning_move)
+{
+    ref_context.vcf_node_limit = ref_context.vcf_nodes + ref_settings.vcf_node_budget;
+
+    return search_vcf(ref_context, side, ref_settings.max_vcf_depth, ref_winning_move);
+}
+
+
+/*
+<Summary> :: searches the continuous-four sequences of the attacking side, where the opponent's only reply to a four is to block it
+<Parameter "ref_context"> :: a reference to the search context, whose position has the attacking side to move
+<Parameter "side"> :: the attacking side (0 = player, 1 = AI)
+<Parameter "remaining_depth"> :: the number of fours that the attacking side may still make
+<Parameter "ref_winning_move"> :: a reference to the variable storing the winning move of the attacking side
+<Return> :: whether the attacking side can win
+*/
+bool search_vcf(search_context &ref_context, int side, int remaining_depth, int &ref_winning_move)
+{
+    bitboard_position &ref_position {ref_context.position};
+    int moves[225];
+    int total_moves;
+    int opponent_points[225];
+    int total_opponent_points;
+
+    ref_context.vcf_nodes++;
+
+    // gives up at the deadline or on cancellation by using up the node budget, where the clock is read once every 256 nodes
+    if ((ref_context.vcf_nodes & 255) == 0 && (std::chrono::steady_clock::now() >= ref_context.deadline || (ref_context.p_cancel_signal != nullptr && ref_context.p_cancel_signal->load(std::memory_order_relaxed))))
+        ref_context.vcf_node_limit = ref_context.vcf_nodes;
+
+    // wins at once if the attacking side already has a four
+    if (find_threat_points(ref_position, side, 4, moves) > 0)
+    {
+        ref_winning_move = moves[0];
+        return true;
+    }
+
+    if (remaining_depth == 0 || ref_context.vcf_nodes >= ref_context.vcf_node_limit)
+        return false;
+
+    total_moves = find_threat_points(ref_position, side, 3, moves);
+
+    // the attacking side must block a four of the opponent, so only a block that makes a four at the same time keeps the sequence going
+    total_opponent_points = find_threat_points(ref_position, 1 - side, 4, opponent_points);
+    if (total_opponent_points > 1)
+    {
+        return false;
+    }
+    else if (total_opponent_points == 1)
+    {
+        int block_move {opponent_points[0]};
+
+        total_moves = std::find(moves, moves + total_moves, block_move) != moves + total_moves ? 1 : 0;
+        moves[0] = block_move;
+    }
+
+    for (int index {0}; index < total_moves; index++)
+    {
+        int row {moves[index] / 15};
+        int column {moves[index] % 15};
+        int five_points[225];
+        int total_five_points;
+        bool is_winning {false};
+
+        make_move(ref_position, row, column, side == 0 ? 1 : -1);
+
+        // an open four or a double four cannot be blocked, and a single four leaves the opponent only one reply
+        total_five_points = find_threat_points(ref_position, side, 4, five_points);
+        if (total_five_points > 1)
+        {
+            is_winning = true;
+        }
+        else if (total_five_points == 1)
+        {
+            int block_row {five_points[0] / 15};
+            int block_column {five_points[0] % 15};
+            int next_move;
+
+            make_move(ref_position, block_row, block_column, side == 0 ? -1 : 1);
+            is_winning = search_vcf(ref_context, side, remaining_depth - 1, next_move);
+            unmake_move(ref_position);
+        }
+
+        unmake_move(ref_position);
+
+        if (is_winning)
+        {
+            ref_winning_move = moves[index];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+<Summary> :: finds the empty points that complete a five-point window holding a specified number of stones of one side and no other stones, such as the points that make a five or a four
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "side"> :: the side owning the stones (0 = player, 1 = AI)
+<Parameter "required_stones"> :: the number of the side's stones in the window (4 for the points making a five, or 3 for the points making a four)
+<Parameter "points"> :: an array storing the found points in row-major order, where each point is encoded as (row * 15 + column)
+<Return> :: the number of found points
+*/
+int find_threat_points(const bitboard_position &ref_position, int side, int required_stones, int points[225])
+{
+    unsigned int point_masks[15] {};
+    int total_points {0};
+
+    // collects the points as row masks, which removes the points found along several lines
+    for (int line {0}; line < 15; line++)
+    {
+        unsigned int row_points {find_line_threats(ref_position.row_masks[side][line], ref_position.row_masks[1 - side][line], 0x7FFF, required_stones)};
+        unsigned int column_points {find_line_threats(ref_position.column_masks[side][line], ref_position.column_masks[1 - side][line], 0x7FFF, required_stones)};
+
+        point_masks[line] |= row_points;
+
+        for (int row {0}; column_points >> row; row++)
+            if ((column_points >> row) & 1)
+                point_masks[row] |= 1 << line;
+    }
+
+    for (int line {0}; line < 29; line++)
+    {
+        unsigned int major_diagonal_points {find_line_threats(ref_position.major_diagonal_masks[side][line], ref_position.major_diagonal_masks[1 - side][line], get_diagonal_mask(line), required_stones)};
+        unsigned int minor_diagonal_points {find_line_threats(ref_position.minor_diagonal_masks[side][line], ref_position.minor_diagonal_masks[1 - side][line], get_diagonal_mask(line), required_stones)};
+
+        for (int column {0}; major_diagonal_points >> column; column++)
+            if ((major_diagonal_points >> column) & 1)
+                point_masks[column - line + 14] |= 1 << column;
+
+        for (int column {0}; minor_diagonal_points >> column; column++)
+            if ((minor_diagonal_points >> column) & 1)
+                point_masks[line - column] |= 1 << column;
+    }
+
+    for (int row {0}; row < 15; row++)
+        for (int column {0}; point_masks[row] >> column; column++)
+            if ((point_masks[row] >> column) & 1)
+                points[total_points++] = row * 15 + column;
+
+    return total_points;
+}
+
+
+/*
+<Summary> :: finds the empty points of a line that complete a five-point window holding a specified number of one side's stones and no opponent's stones
+<Parameter "own_mask"> :: the line mask of the side's stones
+<Parameter "opponent_mask"> :: the line mask of the opponent's stones
+<Parameter "valid_mask"> :: the line mask of the points on the gomoku board
+<Parameter "required_stones"> :: the number of the side's stones in the window
+<Return> :: the line mask of the found points
+*/
+unsigned int find_line_threats(unsigned int own_mask, unsigned int opponent_mask, unsigned int valid_mask, int required_stones)
+{
+    unsigned int threat_mask {0};
+
+    // skips the lines without enough stones, which are most of the lines
+    if (static_cast<int>(std::bitset<15>(own_mask).count()) < required_stones)
+        return 0;
+
+    for (int bit {0}; bit <= 10; bit++)
+    {
+        unsigned int window {0x1Fu << bit};
+
+        if ((valid_mask & window) != window || (opponent_mask & window))
+            continue;
+
+        if (static_cast<int>(std::bitset<15>(own_mask & window).count()) == required_stones)
+            threat_mask |= window & ~own_mask;
+    }
+
+    return threat_mask;
+}
+
+
+/*
+<Summary> :: reads a board from a text file, proves or disproves a forced win for the side to move with the proof-number search, and prints the result
+<Parameter "p_board_path"> :: the path of the board file, which has 15 lines of 15 characters ('.' = empty point, 'X' = player's stone, 'O' = AI's stone)
+<Parameter "p_attacker"> :: the side to move, which is "X" or "O"
+<Parameter "node_limit"> :: the maximum number of nodes to be searched
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int run_proof_analysis(const char *p_board_path, const char *p_attacker, long long node_limit)
+{
+    std::ifstream board_file {p_board_path};
+    std::string attacker {p_attacker};
+    proof_search *p_search {new proof_search};
+    const proof_entry *p_root_entry;
+    int sequence[225];
+    int sequence_length;
+
+    // exits the current function if the side to move is unknown
+    if (attacker != "X" && attacker != "O")
+    {
+        delete p_search;
+        return __LINE__;
+    }
+
+    clear_position(p_search->position, 1);
+
+    for (int row {0}; row < 15; row++)
+    {
+        std::string board_line;
+
+        // exits the current function if the board file is missing or has fewer than 15 valid lines
+        if (!std::getline(board_file, board_line) || board_line.size() < 15)
+        {
+            delete p_search;
+            return __LINE__;
+        }
+
+        for (int column {0}; column < 15; column++)
+        {
+            if (board_line[column] == 'X')
+            {
+                place_stone(p_search->position, row, column, 1);
+            }
+            else if (board_line[column] == 'O')
+            {
+                place_stone(p_search->position, row, column, -1);
+            }
+            else if (board_line[column] != '.')
+            {
+                delete p_search;
+                return __LINE__;
+            }
+        }
+    }
+
+    p_search->attacker_side = attacker == "X" ? 0 : 1;
+    p_search->total_nodes = 0;
+    p_search->node_limit = node_limit;
+    p_search->is_aborted = false;
+    clear_proof_table(*p_search, 1 << 20);
+
+    search_proof_numbers(*p_search, true, infinite_proof_number, infinite_proof_number);
+
+    p_root_entry = find_proof_entry(*p_search, p_search->position.zobrist_key);
+
+    if (p_root_entry != nullptr && p_root_entry->proof_number == 0)
+    {
+        collect_proof_sequence(*p_search, sequence, sequence_length);
+
+        std::cout << "proven: " << attacker << " wins by force after " << p_search->total_nodes << " nodes\n";
+        std::cout << "sequence (row, column counted from 0 at the top left):";
+
+        for (int index {0}; index < sequence_length; index++)
+            std::cout << ' ' << ((index % 2 == 0) == (attacker == "X") ? 'X' : 'O') << '(' << sequence[index] / 15 << ", " << sequence[index] % 15 << ')';
+
+        std::cout << '\n';
+    }
+    else if (p_root_entry != nullptr && p_root_entry->disproof_number == 0)
+    {
+        std::cout << "disproven: " << attacker << " has no forced win, searched in " << p_search->total_nodes << " nodes\n";
+    }
+    else
+    {
+        std::cout << "unproven within " << node_limit << " nodes\n";
+    }
+
+    delete p_search;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: searches the position of a proof-number search with the depth-first proof-number (df-pn) algorithm until its proof and disproof numbers reach the thresholds
+<Parameter "ref_search"> :: a reference to the proof-number search, whose position is searched
+<Parameter "is_attacker_next"> :: whether the attacking side moves next, which makes the node an OR node
+<Parameter "phi_threshold"> :: the threshold of the proof number for an OR node, or of the disproof number for an AND node
+<Parameter "delta_threshold"> :: the threshold of the disproof number for an OR node, or of the proof number for an AND node
+<Return> :: none
+*/
+void search_proof_numbers(proof_search &ref_search, bool is_attacker_next, unsigned int phi_threshold, unsigned int delta_threshold)
+{
+    bitboard_position &ref_position {ref_search.position};
+    unsigned long long search_key {ref_position.zobrist_key};
+    long long start_nodes {ref_search.total_nodes};
+    int side {is_attacker_next ? ref_search.attacker_side : 1 - ref_search.attacker_side};
+    int moves[225];
+    int total_moves;
+    unsigned int proof_number;
+    unsigned int disproof_number;
+    unsigned int phi;
+    unsigned int delta;
+
+    ref_search.total_nodes++;
+    if (ref_search.total_nodes >= ref_search.node_limit)
+        ref_search.is_aborted = true;
+
+    total_moves = generate_proof_moves(ref_search, is_attacker_next, moves, proof_number, disproof_number);
+
+    // stores the result of a node decided without any move
+    if (total_moves == 0)
+    {
+        store_proof_table(ref_search, search_key, proof_number, disproof_number, 1);
+        return;
+    }
+
+    // phi is the proof number of an OR node or the disproof number of an AND node, and delta is the other one
+    // phi of a node is the minimum delta of its children, and delta of a node is the sum of phi of its children
+    while (true)
+    {
+        int best_index {0};
+        unsigned int best_child_phi {0};
+        unsigned int best_child_delta {infinite_proof_number};
+        unsigned int second_child_delta {infinite_proof_number};
+        unsigned int child_phi_threshold;
+        unsigned int child_delta_threshold;
+
+        delta = 0;
+
+        for (int index {0}; index < total_moves; index++)
+        {
+            const proof_entry *p_child_entry {find_proof_entry(ref_search, search_key ^ zobrist_keys[side][moves[index] / 15][moves[index] % 15])};
+            unsigned int child_phi {1};
+            unsigned int child_delta {1};
+
+            // an unvisited child is given the proof and disproof numbers of a single leaf
+            if (p_child_entry != nullptr)
+            {
+                child_phi = is_attacker_next ? p_child_entry->disproof_number : p_child_entry->proof_number;
+                child_delta = is_attacker_next ? p_child_entry->proof_number : p_child_entry->disproof_number;
+            }
+
+            if (child_delta < best_child_delta)
+            {
+                second_child_delta = best_child_delta;
+                best_child_delta = child_delta;
+                best_child_phi = child_phi;
+                best_index = index;
+            }
+            else if (child_delta < second_child_delta)
+            {
+                second_child_delta = child_delta;
+            }
+
+            // keeps a sum below infinity unless a child is infinite, since only a decided child can decide the node
+            if (child_phi == infinite_proof_number || delta == infinite_proof_number)
+                delta = infinite_proof_number;
+            else
+                delta = delta + child_phi < infinite_proof_number - 1 ? delta + child_phi : infinite_proof_number - 1;
+        }
+
+        phi = best_child_delta;
+
+        if (phi >= phi_threshold || delta >= delta_threshold || ref_search.is_aborted)
+            break;
+
+        // searches the most proving child until it is no longer the best child or the node reaches its thresholds
+        child_phi_threshold = delta_threshold - delta + best_child_phi;
+        child_delta_threshold = phi_threshold < second_child_delta + 1 ? phi_threshold : second_child_delta + 1;
+
+        make_move(ref_position, moves[best_index] / 15, moves[best_index] % 15, side == 0 ? 1 : -1);
+        search_proof_numbers(ref_search, !is_attacker_next, child_phi_threshold, child_delta_threshold);
+        unmake_move(ref_position);
+    }
+
+    proof_number = is_attacker_next ? phi : delta;
+    disproof_number = is_attacker_next ? delta : phi;
+    store_proof_table(ref_search, search_key, proof_number, disproof_number, ref_search.total_nodes - start_nodes);
+
+    return;
+}
+
+
+/*
+<Summary> :: generates the moves of a node in the proof-number search, or decides the node if the side to move wins or loses at once
+<Parameter "ref_search"> :: a reference to the proof-number search
+<Parameter "is_attacker_next"> :: whether the attacking side moves next
+<Parameter "moves"> :: an array storing the moves, where each move is encoded as (row * 15 + column)
+<Parameter "ref_proof_number"> :: a reference to the variable storing the proof number of a decided node
+<Parameter "ref_disproof_number"> :: a reference to the variable storing the disproof number of a decided node
+<Return> :: the number of moves, which is 0 if the node is decided
+*/
+int generate_proof_moves(proof_search &ref_search, bool is_attacker_next, int moves[225], unsigned int &ref_proof_number, unsigned int &ref_disproof_number)
+{
+    int side {is_attacker_next ? ref_search.attacker_side : 1 - ref_search.attacker_side};
+    int five_points[225];
+    int total_opponent_five_points;
+    int total_moves;
+
+    // the side to move wins if it can make a five, and loses if the opponent has two points to make a five
+    if (find_threat_points(ref_search.position, side, 4, five_points) > 0)
+    {
+        ref_proof_number = is_attacker_next ? 0 : infinite_proof_number;
+        ref_disproof_number = is_attacker_next ? infinite_proof_number : 0;
+        return 0;
+    }
+
+    total_opponent_five_points = find_threat_points(ref_search.position, 1 - side, 4, five_points);
+    if (total_opponent_five_points > 1)
+    {
+        ref_proof_number = is_attacker_next ? infinite_proof_number : 0;
+        ref_disproof_number = is_attacker_next ? 0 : infinite_proof_number;
+        return 0;
+    }
+
+    // the side to move must block a single four of the opponent
+    if (total_opponent_five_points == 1)
+    {
+        moves[0] = five_points[0];
+        return 1;
+    }
+
+    // a full board is a draw, which disproves the attacking side's win
+    total_moves = generate_candidate_moves(ref_search.position, moves);
+    if (total_moves == 0)
+    {
+        ref_proof_number = infinite_proof_number;
+        ref_disproof_number = 0;
+    }
+
+    return total_moves;
+}
+
+
+/*
+<Summary> :: follows the proven entries from the root to collect a winning sequence, where the attacking side plays a proven move and the defending side plays the defense that took the most nodes to prove
+<Parameter "ref_search"> :: a reference to the proof-number search, whose root has been proven
+<Parameter "sequence"> :: an array storing the moves of the sequence, where each move is encoded as (row * 15 + column)
+<Parameter "ref_sequence_length"> :: a reference to the variable storing the number of moves in the sequence
+<Return> :: none
+*/
+void collect_proof_sequence(proof_search &ref_search, int sequence[225], int &ref_sequence_length)
+{
+    bitboard_position &ref_position {ref_search.position};
+    bool is_attacker_next {true};
+
+    ref_sequence_length = 0;
+
+    while (ref_sequence_length < 225)
+    {
+        int side {is_attacker_next ? ref_search.attacker_side : 1 - ref_search.attacker_side};
+        int moves[225];
+        int total_moves;
+        int chosen_move {-1};
+        unsigned int chosen_work {0};
+        unsigned int proof_number;
+        unsigned int disproof_number;
+
+        // ends the sequence with the five of the attacking side
+        if (is_attacker_next && find_threat_points(ref_position, side, 4, moves) > 0)
+        {
+            sequence[ref_sequence_length++] = moves[0];
+            break;
+        }
+
+        total_moves = generate_proof_moves(ref_search, is_attacker_next, moves, proof_number, disproof_number);
+
+        // blocks one of the two points of an unstoppable four, after which the attacking side makes the five
+        if (!is_attacker_next && total_moves == 0 && find_threat_points(ref_position, 1 - side, 4, moves) > 0)
+            chosen_move = moves[0];
+
+        for (int index {0}; index < total_moves; index++)
+        {
+            const proof_entry *p_child_entry {find_proof_entry(ref_search, ref_position.zobrist_key ^ zobrist_keys[side][moves[index] / 15][moves[index] % 15])};
+
+            if (p_child_entry == nullptr || p_child_entry->proof_number != 0)
+                continue;
+
+            if (chosen_move == -1 || (!is_attacker_next && p_child_entry->work > chosen_work))
+            {
+                chosen_move = moves[index];
+                chosen_work = p_child_entry->work;
+            }
+
+            if (is_attacker_next)
+                break;
+        }
+
+        // stops at a node whose proof has been replaced in the table
+        if (chosen_move == -1)
+            break;
+
+        make_move(ref_position, chosen_move / 15, chosen_move % 15, side == 0 ? 1 : -1);
+        sequence[ref_sequence_length++] = chosen_move;
+        is_attacker_next = !is_attacker_next;
+    }
+
+    // restores the root position, unmaking every placed stone in reverse order except the final five which is not placed
+    for (int index {ref_sequence_length - 1}; index >= 0; index--)
+        if ((ref_position.row_masks[0][sequence[index] / 15] | ref_position.row_masks[1][sequence[index] / 15]) >> (sequence[index] % 15) & 1)
+            unmake_move(ref_position);
+
+    return;
+}
+
+
+/*
+<Summary> :: allocates the fixed-size proof table of a proof-number search and clears all its entries
+<Parameter "ref_search"> :: a reference to the proof-number search
+<Parameter "total_entries"> :: the number of entries, which must be a power of two and a multiple of the bucket size
+<Return> :: none
+*/
+void clear_proof_table(proof_search &ref_search, int total_entries)
+{
+    ref_search.entries.assign(total_entries, proof_entry {0, 0, 0, 0});
+
+    return;
+}
+
+
+/*
+<Summary> :: finds the entry of a position in the proof table
+<Parameter "ref_search"> :: a reference to the proof-number search
+<Parameter "search_key"> :: the Zobrist key of the position
+<Return> :: a pointer to the entry, or nullptr if the position is not stored
+*/
+const proof_entry *find_proof_entry(const proof_search &ref_search, unsigned long long search_key)
+{
+    std::size_t first_index {(search_key & (ref_search.entries.size() - 1)) & ~static_cast<std::size_t>(3)};
+
+    for (std::size_t index {first_index}; index < first_index + 4; index++)
+        if (ref_search.entries[index].work != 0 && ref_search.entries[index].key == search_key)
+            return &ref_search.entries[index];
+
+    return nullptr;
+}
+
+
+/*
+<Summary> :: stores the proof and disproof numbers of a position in its bucket of four entries, replacing the entry that took the fewest nodes when the bucket is full
+<Parameter "ref_search"> :: a reference to the proof-number search
+<Parameter "search_key"> :: the Zobrist key of the position
+<Parameter "proof_number"> :: the proof number of the position
+<Parameter "disproof_number"> :: the disproof number of the position
+<Parameter "work"> :: the number of nodes searched below the position, which decides how valuable the entry is to keep
+<Return> :: none
+*/
+void store_proof_table(proof_search &ref_search, unsigned long long search_key, unsigned int proof_number, unsigned int disproof_number, long long work)
+{
+    std::size_t first_index {(search_key & (ref_search.entries.size() - 1)) & ~static_cast<std::size_t>(3)};
+    std::size_t replaced_index {first_index};
+
+    // keeps the table within its fixed size by overwriting the cheapest entry, so the search can run for any number of nodes
+    for (std::size_t index {first_index}; index < first_index + 4; index++)
+    {
+        if (ref_search.entries[index].work != 0 && ref_search.entries[index].key == search_key)
+        {
+            replaced_index = index;
+            work += ref_search.entries[index].work;
+            break;
+        }
+
+        if (ref_search.entries[index].work < ref_search.entries[replaced_index].work)
+            replaced_index = index;
+    }
+
+    ref_search.entries[replaced_index] = proof_entry {search_key, proof_number, disproof_number, static_cast<unsigned int>(work < 0xFFFFFFFF ? work : 0xFFFFFFFF)};
+
+    return;
+}
+
+
+/*
+<Summary> :: maps an opening book file into memory, where the file starts with the 8-byte magic "GMKBOOK1", a 4-byte version, and a 4-byte entry count, followed by the sorted entries
+<Parameter "ref_book"> :: a reference to the opening book to be opened, which is left empty if the file does not exist
+<Parameter "p_book_path"> :: the path of the book file
+<Return> :: the return value would be 0 if the function succeeds or the file does not exist; otherwise the return value would be the line number where the error occurs
+*/
+int open_opening_book(opening_book &ref_book, const char *p_book_path)
+{
+    const unsigned char *p_header;
+    unsigned int version;
+    unsigned int total_entries;
+
+#ifdef _WIN32
+    LARGE_INTEGER file_size;
+
+    ref_book.p_file_handle = INVALID_HANDLE_VALUE;
+    ref_book.p_mapping_handle = NULL;
+#else
+    struct stat file_status;
+
+    ref_book.file_descriptor = -1;
+#endif
+    ref_book.p_view = nullptr;
+    ref_book.view_size = 0;
+    ref_book.p_entries = nullptr;
+    ref_book.total_entries = 0;
+
+#ifdef _WIN32
+    // plays without a book if the file does not exist
+    ref_book.p_file_handle = CreateFileA(p_book_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (ref_book.p_file_handle == INVALID_HANDLE_VALUE)
+        return 0;
+
+    // exits the current function if the size of the file is unknown
+    if (!GetFileSizeEx(ref_book.p_file_handle, &file_size))
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    ref_book.view_size = file_size.QuadPart;
+#else
+    // plays without a book if the file does not exist
+    ref_book.file_descriptor = open(p_book_path, O_RDONLY);
+    if (ref_book.file_descriptor == -1)
+        return 0;
+
+    // exits the current function if the size of the file is unknown
+    if (fstat(ref_book.file_descriptor, &file_status) != 0)
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    ref_book.view_size = file_status.st_size;
+#endif
+
+    // leaves an empty file unmapped, since it cannot be mapped
+    if (ref_book.view_size == 0)
+    {
+        close_opening_book(ref_book);
+        return 0;
+    }
+
+#ifdef _WIN32
+    ref_book.p_mapping_handle = CreateFileMappingA(ref_book.p_file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (ref_book.p_mapping_handle == NULL)
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    ref_book.p_view = MapViewOfFile(ref_book.p_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+#else
+    ref_book.p_view = mmap(nullptr, static_cast<std::size_t>(ref_book.view_size), PROT_READ, MAP_SHARED, ref_book.file_descriptor, 0);
+    if (ref_book.p_view == MAP_FAILED)
+        ref_book.p_view = nullptr;
+#endif
+
+    if (ref_book.p_view == nullptr)
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    // exits the current function if the header is not of a book file, or the entry count does not match the file size
+    p_header = static_cast<const unsigned char *>(ref_book.p_view);
+    if (ref_book.view_size < 16 || std::memcmp(p_header, "GMKBOOK1", 8) != 0)
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    std::memcpy(&version, p_header + 8, 4);
+    std::memcpy(&total_entries, p_header + 12, 4);
+    if (version != 1 || ref_book.view_size != 16 + static_cast<long long>(total_entries) * static_cast<long long>(sizeof(book_entry)))
+    {
+        close_opening_book(ref_book);
+        return __LINE__;
+    }
+
+    ref_book.p_entries = reinterpret_cast<const book_entry *>(p_header + 16);
+    ref_book.total_entries = total_entries;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: unmaps the file of an opening book and closes its handles, which leaves the book empty
+<Parameter "ref_book"> :: a reference to the opening book to be closed
+<Return> :: none
+*/
+void close_opening_book(opening_book &ref_book)
+{
+#ifdef _WIN32
+    if (ref_book.p_view != nullptr)
+        UnmapViewOfFile(ref_book.p_view);
+
+    if (ref_book.p_mapping_handle != NULL)
+        CloseHandle(ref_book.p_mapping_handle);
+
+    if (ref_book.p_file_handle != INVALID_HANDLE_VALUE)
+        CloseHandle(ref_book.p_file_handle);
+
+    ref_book.p_file_handle = INVALID_HANDLE_VALUE;
+    ref_book.p_mapping_handle = NULL;
+#else
+    if (ref_book.p_view != nullptr)
+        munmap(const_cast<void *>(ref_book.p_view), static_cast<std::size_t>(ref_book.view_size));
+
+    if (ref_book.file_descriptor != -1)
+        close(ref_book.file_descriptor);
+
+    ref_book.file_descriptor = -1;
+#endif
+    ref_book.p_view = nullptr;
+    ref_book.view_size = 0;
+    ref_book.p_entries = nullptr;
+    ref_book.total_entries = 0;
+
+    return;
+}
+
+
+/*
+<Summary> :: looks up the replies to a position in the opening book, and picks one of them at random in proportion to their weights
+<Parameter "ref_book"> :: a reference to the opening book
+<Parameter "ref_position"> :: a reference to the position, where the AI is to move
+<Parameter "p_random_engine"> :: a pointer to the random engine of the caller, or nullptr to pick the heaviest reply, where the first of equal replies is picked
+<Parameter "ref_book_move"> :: a reference to the variable storing the picked reply, encoded as (row * 15 + column)
+<Return> :: whether the book has a reply to the position
+*/
+bool find_book_move(const opening_book &ref_book, const bitboard_position &ref_position, std::mt19937 *p_random_engine, int &ref_book_move)
+{
+    int symmetry;
+    unsigned long long book_key;
+    long long first_index {0};
+    long long last_index {ref_book.total_entries};
+    long long total_weight {0};
+    long long max_weight {0};
+    long long picked_weight;
+
+    if (ref_book.total_entries == 0)
+        return false;
+
+    book_key = get_canonical_key(ref_position, symmetry);
+
+    // finds the first entry of the position by binary search, since the entries are sorted by key
+    while (first_index < last_index)
+    {
+        long long middle_index {(first_index + last_index) / 2};
+
+        if (ref_book.p_entries[middle_index].key < book_key)
+            first_index = middle_index + 1;
+        else
+            last_index = middle_index;
+    }
+
+    // sums the weights of the replies on empty points, which skips the replies left by another position sharing the key
+    for (long long index {first_index}; index < ref_book.total_entries && ref_book.p_entries[index].key == book_key; index++)
+    {
+        int move {restore_move(ref_book.p_entries[index].move, symmetry)};
+
+        if (move != -1 && !(((ref_position.row_masks[0][move / 15] | ref_position.row_masks[1][move / 15]) >> (move % 15)) & 1))
+        {
+            total_weight += ref_book.p_entries[index].weight;
+            max_weight = std::max(max_weight, static_cast<long long>(ref_book.p_entries[index].weight));
+        }
+    }
+
+    if (total_weight == 0)
+        return false;
+
+    picked_weight = p_random_engine != nullptr ? std::uniform_int_distribution<long long> {0, total_weight - 1}(*p_random_engine) : 0;
+
+    for (long long index {first_index}; index < ref_book.total_entries && ref_book.p_entries[index].key == book_key; index++)
+    {
+        int move {restore_move(ref_book.p_entries[index].move, symmetry)};
+
+        if (move == -1 || (((ref_position.row_masks[0][move / 15] | ref_position.row_masks[1][move / 15]) >> (move % 15)) & 1))
+            continue;
+
+        picked_weight -= ref_book.p_entries[index].weight;
+        if (p_random_engine != nullptr ? picked_weight < 0 : ref_book.p_entries[index].weight == max_weight)
+        {
+            ref_book_move = move;
+            break;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+<Summary> :: transforms a move by one of the eight symmetries of the board, which mirrors the columns if bit 2 of the symmetry is set, and then rotates the board clockwise by 90 degrees as many times as the lowest two bits
+<Parameter "move"> :: the move to be transformed, encoded as (row * 15 + column)
+<Parameter "symmetry"> :: the symmetry from 0 to 7, where 0 leaves the move unchanged
+<Return> :: the transformed move, encoded as (row * 15 + column)
+*/
+int transform_move(int move, int symmetry)
+{
+    int row {move / 15};
+    int column {move % 15};
+
+    if (symmetry & 4)
+        column = 14 - column;
+
+    for (int turn {0}; turn < (symmetry & 3); turn++)
+    {
+        int rotated_row {column};
+
+        column = 14 - row;
+        row = rotated_row;
+    }
+
+    return row * 15 + column;
+}
+
+
+/*
+<Summary> :: transforms a move of the book back to the board by the inverse of a symmetry, which undoes the rotations first and the mirroring last
+<Parameter "move"> :: the move in the book, encoded as (row * 15 + column)
+<Parameter "symmetry"> :: the symmetry that transforms the board into the book
+<Return> :: the move on the board encoded as (row * 15 + column), or -1 if the move is outside the board
+*/
+int restore_move(int move, int symmetry)
+{
+    int row {move / 15};
+    int column {move % 15};
+
+    if (move < 0 || move >= 225)
+        return -1;
+
+    for (int turn {0}; turn < (symmetry & 3); turn++)
+    {
+        int rotated_row {14 - column};
+
+        column = row;
+        row = rotated_row;
+    }
+
+    if (symmetry & 4)
+        column = 14 - column;
+
+    return row * 15 + column;
+}
+
+
+/*
+<Summary> :: builds or extends an opening book from AI self-play games or from game records, where the program is started as
+            "gomoku --build-book <book file> selfplay <games> <book stones> <milliseconds per move>" or "gomoku --build-book <book file> records <record file> <book stones>"
+<Parameter "argc"> :: the number of command line arguments
+<Parameter "argv"> :: the command line arguments
+<Parameter "ref_settings"> :: a reference to the settings of the self-play games and of the recorded positions, whose time budget is replaced by the one on the command line
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int run_book_builder(int argc, char *argv[], const search_settings &ref_settings)
+{
+    std::string source {argv[3]};
+    opening_book old_book;
+    std::vector<book_entry> entries;
+    int error_code;
+    int max_stones;
+    int total_games {0};
+
+    // exits the current function if the source or its arguments are unknown
+    if (!(source == "selfplay" && argc >= 7) && !(source == "records" && argc >= 6))
+        return __LINE__;
+
+    max_stones = std::atoi(argv[5]);
+    if (max_stones < 1 || max_stones > 225)
+        return __LINE__;
+
+    // keeps the entries of the existing book, so that the new games add to their weights
+    if ((error_code = open_opening_book(old_book, argv[2])))
+        return error_code;
+
+    entries.assign(old_book.p_entries, old_book.p_entries + old_book.total_entries);
+    close_opening_book(old_book);
+
+    if (source == "selfplay")
+    {
+        transposition_table *p_table {new transposition_table};
+        search_settings settings {ref_settings};
+        std::mt19937 random_engine {std::random_device {}()};
+        int total_planned_games {std::atoi(argv[4])};
+
+        settings.time_budget_milliseconds = std::atoi(argv[6]) > 0 ? std::atoi(argv[6]) : 1;
+        clear_transposition_table(*p_table, 1 << 20);
+
+        for (; total_games < total_planned_games; total_games++)
+        {
+            std::vector<int> moves;
+
+            if ((error_code = play_book_game(*p_table, settings, random_engine, moves)))
+            {
+                delete p_table;
+                return error_code;
+            }
+
+            record_book_game(entries, moves, max_stones, ref_settings.frontier_radius);
+            std::cout << "game " << total_games + 1 << ": " << moves.size() << " moves\n";
+        }
+
+        delete p_table;
+    }
+    else
+    {
+        std::ifstream record_file {argv[4]};
+        std::string record_line;
+
+        // exits the current function if the record file is missing
+        if (!record_file)
+            return __LINE__;
+
+        while (std::getline(record_file, record_line))
+        {
+            std::vector<int> moves;
+
+            if ((error_code = read_book_record(record_line, moves)))
+                return error_code;
+
+            if (moves.empty())
+                continue;
+
+            record_book_game(entries, moves, max_stones, ref_settings.frontier_radius);
+            total_games++;
+        }
+    }
+
+    if ((error_code = save_opening_book(argv[2], entries)))
+        return error_code;
+
+    std::cout << "recorded " << total_games << " games into " << entries.size() << " book entries\n";
+
+    return 0;
+}
+
+
+/*
+<Summary> :: plays a game between two copies of the AI for the opening book, where the second and third stones are placed at random so that the games cover different openings
+<Parameter "ref_table"> :: a reference to the transposition table shared by both sides
+<Parameter "ref_settings"> :: a reference to the settings of both sides, which do not use the opening book
+<Parameter "ref_random_engine"> :: a reference to the random engine that places the random stones
+<Parameter "ref_moves"> :: a reference to the vector storing the moves of the game, encoded as (row * 15 + column)
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int play_book_game(transposition_table &ref_table, const search_settings &ref_settings, std::mt19937 &ref_random_engine, std::vector<int> &ref_moves)
+{
+    search_context *p_context {new search_context};
+    search_report report;
+
+    ref_moves.assign(1, 7 * 15 + 7);
+
+    while (true)
+    {
+        int move;
+
+        // sets up the position with the side to move as the AI, which lets the same search play both sides
+        set_up_game_position(p_context->position, ref_moves, static_cast<int>(ref_moves.size()), ref_settings.frontier_radius);
+        if (check_battle_state(p_context->position))
+            break;
+
+        if (ref_moves.size() < 3)
+        {
+            int moves[225];
+            int total_moves {generate_candidate_moves(p_context->position, moves)};
+
+            move = moves[std::uniform_int_distribution<int> {0, total_moves - 1}(ref_random_engine)];
+        }
+        else
+        {
+            prepare_search_context(*p_context, &ref_table, nullptr, &ref_random_engine, nullptr);
+
+            move = search_ai_move(*p_context, ref_settings, report);
+        }
+
+        // exits the current function if the search returns no move or an occupied point
+        if (move == -1 || ((p_context->position.row_masks[0][move / 15] | p_context->position.row_masks[1][move / 15]) >> (move % 15)) & 1)
+        {
+            delete p_context;
+            return __LINE__;
+        }
+
+        ref_moves.push_back(move);
+    }
+
+    delete p_context;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: reads the moves of a game from one line of a record file, where the moves are written as "row,column" counted from 0 at the top left and separated by spaces
+<Parameter "ref_record_line"> :: a reference to the line of the record file, which starts with the first mover's move and may be empty
+<Parameter "ref_moves"> :: a reference to the vector storing the moves of the game, encoded as (row * 15 + column)
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int read_book_record(const std::string &ref_record_line, std::vector<int> &ref_moves)
+{
+    std::bitset<225> occupied_points;
+    std::size_t position {0};
+
+    ref_moves.clear();
+
+    while ((position = ref_record_line.find_first_not_of(" \t\r", position)) != std::string::npos)
+    {
+        int row;
+        int column;
+        int length;
+
+        // exits the current function if a move is not written as two numbers on the board, or is placed on an occupied point
+        if (std::sscanf(ref_record_line.c_str() + position, "%d,%d%n", &row, &column, &length) != 2 || row < 0 || row >= 15 || column < 0 || column >= 15 || occupied_points[row * 15 + column])
+            return __LINE__;
+
+        occupied_points[row * 15 + column] = true;
+        ref_moves.push_back(row * 15 + column);
+        position += length;
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: adds the moves of a game to the book entries, where each move of the winner adds 2 to its weight, each move of a drawn game adds 1, and the moves of the loser are not added
+<Parameter "ref_entries"> :: a reference to the book entries, which may contain the same reply more than once until they are saved
+<Parameter "ref_moves"> :: a reference to the moves of the game, encoded as (row * 15 + column)
+<Parameter "max_stones"> :: the number of stones below which the moves are added
+<Parameter "frontier_radius"> :: the square radius around the stones where the candidate moves of the replayed positions are generated
+<Return> :: none
+*/
+void record_book_game(std::vector<book_entry> &ref_entries, const std::vector<int> &ref_moves, int max_stones, int frontier_radius)
+{
+    bitboard_position *p_position {new bitboard_position};
+    int total_moves {static_cast<int>(ref_moves.size())};
+    bool is_decided;
+
+    // the game is decided if its last move makes five in a row, and drawn otherwise
+    set_up_game_position(*p_position, ref_moves, total_moves, frontier_radius);
+    is_decided = check_last_move_five(*p_position);
+
+    // the side that made the last move is the winner, which moves at the plies of the same parity as the last move
+    for (int ply {0}; ply < total_moves && ply < max_stones; ply++)
+    {
+        unsigned short weight {static_cast<unsigned short>(!is_decided ? 1 : (total_moves - 1 - ply) % 2 == 0 ? 2 : 0)};
+        int symmetry;
+        unsigned long long book_key;
+
+        if (weight == 0)
+            continue;
+
+        set_up_game_position(*p_position, ref_moves, ply, frontier_radius);
+        book_key = get_canonical_key(*p_position, symmetry);
+        ref_entries.push_back({book_key, static_cast<unsigned short>(transform_move(ref_moves[ply], symmetry)), weight, 0});
+    }
+
+    delete p_position;
+
+    return;
+}
+
+
+/*
+<Summary> :: sets up the position after the first moves of a game, where the stones of the side to move are placed as the AI's stones and the others as the player's stones
+<Parameter "ref_position"> :: a reference to the position to be set up
+<Parameter "ref_moves"> :: a reference to the moves of the game, encoded as (row * 15 + column)
+<Parameter "total_moves"> :: the number of moves to be placed
+<Parameter "frontier_radius"> :: the square radius around the stones where the candidate moves of the position are generated
+<Return> :: none
+*/
+void set_up_game_position(bitboard_position &ref_position, const std::vector<int> &ref_moves, int total_moves, int frontier_radius)
+{
+    clear_position(ref_position, frontier_radius);
+
+    for (int ply {0}; ply < total_moves; ply++)
+    {
+        make_move(ref_position, ref_moves[ply] / 15, ref_moves[ply] % 15, (total_moves - ply) % 2 == 0 ? -1 : 1);
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: merges the same replies of the book entries by adding their weights, and writes the entries sorted by key and move to a book file
+<Parameter "p_book_path"> :: the path of the book file, which is overwritten
+<Parameter "ref_entries"> :: a reference to the book entries, which are sorted and merged in place
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int save_opening_book(const char *p_book_path, std::vector<book_entry> &ref_entries)
+{
+    std::ofstream book_file {p_book_path, std::ios::binary | std::ios::trunc};
+    std::size_t total_merged_entries {0};
+    unsigned int version {1};
+    unsigned int total_entries;
+
+    std::sort(ref_entries.begin(), ref_entries.end(), [](const book_entry &ref_first, const book_entry &ref_second) { return ref_first.key != ref_second.key ? ref_first.key < ref_second.key : ref_first.move < ref_second.move; });
+
+    // limits the merged weight to the largest value of an unsigned short
+    for (const book_entry &ref_entry : ref_entries)
+    {
+        if (total_merged_entries > 0 && ref_entries[total_merged_entries - 1].key == ref_entry.key && ref_entries[total_merged_entries - 1].move == ref_entry.move)
+            ref_entries[total_merged_entries - 1].weight = static_cast<unsigned short>(std::min(65535, ref_entries[total_merged_entries - 1].weight + ref_entry.weight));
+        else
+            ref_entries[total_merged_entries++] = ref_entry;
+    }
+
+    ref_entries.resize(total_merged_entries);
+    total_entries = static_cast<unsigned int>(ref_entries.size());
+
+    // exits the current function if the book file cannot be written
+    if (!book_file)
+        return __LINE__;
+
+    book_file.write("GMKBOOK1", 8);
+    book_file.write(reinterpret_cast<const char *>(&version), 4);
+    book_file.write(reinterpret_cast<const char *>(&total_entries), 4);
+    book_file.write(reinterpret_cast<const char *>(ref_entries.data()), static_cast<std::streamsize>(ref_entries.size() * sizeof(book_entry)));
+
+    if (!book_file)
+        return __LINE__;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: clears all stones, line values, Zobrist key, frontier, and the last move record of a specified bitboard position
+<Parameter "ref_position"> :: a reference to the bitboard position to be cleared
+<Parameter "frontier_radius"> :: the square radius around the stones where the candidate moves are generated
+<Return> :: none
+*/
+void clear_position(bitboard_position &ref_position, int frontier_radius)
+{
+    for (int side {0}; side < 2; side++)
+    {
+        for (int line {0}; line < 15; line++)
+        {
+            ref_position.row_masks[side][line] = 0;
+            ref_position.column_masks[side][line] = 0;
+        }
+
+        for (int line {0}; line < 29; line++)
+        {
+            ref_position.major_diagonal_masks[side][line] = 0;
+            ref_position.minor_diagonal_masks[side][line] = 0;
+        }
+
+        ref_position.total_center_weights[side] = 0;
+    }
+
+    for (int line {0}; line < 15; line++)
+    {
+        ref_position.row_values[line] = 0;
+        ref_position.column_values[line] = 0;
+    }
+
+    for (int line {0}; line < 29; line++)
+    {
+        ref_position.major_diagonal_values[line] = 0;
+        ref_position.minor_diagonal_values[line] = 0;
+    }
+
+    ref_position.total_stones = 0;
+    ref_position.last_placed_row = -1;
+    ref_position.last_placed_column = -1;
+    ref_position.total_line_value = 0;
+    ref_position.zobrist_key = 0;
+
+    for (int symmetry {0}; symmetry < 8; symmetry++)
+        ref_position.symmetric_keys[symmetry] = 0;
+
+    for (int move {0}; move < 225; move++)
+    {
+        ref_position.frontier_indexes[move] = 255;
+        ref_position.neighbor_counts[move] = 0;
+    }
+
+    ref_position.frontier_radius = frontier_radius;
+    ref_position.total_frontier_moves = 0;
+
+    return;
+}
+
+
+/*
+<Summary> :: places a stone on an empty point of a specified bitboard position by setting its bit in the four line masks passing through the point, and updates the board value, Zobrist keys, and frontier accordingly
+<Parameter "ref_position"> :: a reference to the bitboard position where the stone is placed
+<Parameter "row"> :: the row index of the empty point
+<Parameter "column"> :: the column index of the empty point
+<Parameter "stone"> :: the stone to be placed (1 = player's stone, -1 = AI's stone)
+<Return> :: none
+*/
+void place_stone(bitboard_position &ref_position, int row, int column, int stone)
+{
+    int side {stone == 1 ? 0 : 1};
+
+    ref_position.row_masks[side][row] |= 1 << column;
+    ref_position.column_masks[side][column] |= 1 << row;
+    ref_position.major_diagonal_masks[side][column - row + 14] |= 1 << column;
+    ref_position.minor_diagonal_masks[side][row + column] |= 1 << column;
+    ref_position.total_stones++;
+    ref_position.total_center_weights[side] += 15 - abs(row - 7) - abs(column - 7);
+    ref_position.zobrist_key ^= zobrist_keys[side][row][column];
+
+    for (int symmetry {0}; symmetry < 8; symmetry++)
+    {
+        int symmetric_point {symmetric_points[symmetry][row * 15 + column]};
+
+        ref_position.symmetric_keys[symmetry] ^= zobrist_keys[side][symmetric_point / 15][symmetric_point % 15];
+    }
+
+    update_line_values(ref_position, row, column);
+    update_frontier(ref_position, row, column, 1);
+
+    return;
+}
+
+
+/*
+<Summary> :: removes a stone from a specified bitboard position by clearing its bit in the four line masks passing through the point, and updates the board value, Zobrist keys, and frontier accordingly
+<Parameter "ref_position"> :: a reference to the bitboard position where the stone is removed
+<Parameter "row"> :: the row index of the stone
+<Parameter "column"> :: the column index of the stone
+<Return> :: none
+*/
+void remove_stone(bitboard_position &ref_position, int row, int column)
+{
+    int side {(ref_position.row_masks[0][row] >> column) & 1 ? 0 : 1};
+
+    ref_position.row_masks[side][row] &= ~(1 << column);
+    ref_position.column_masks[side][column] &= ~(1 << row);
+    ref_position.major_diagonal_masks[side][column - row + 14] &= ~(1 << column);
+    ref_position.minor_diagonal_masks[side][row + column] &= ~(1 << column);
+    ref_position.total_stones--;
+    ref_position.total_center_weights[side] -= 15 - abs(row - 7) - abs(column - 7);
+    ref_position.zobrist_key ^= zobrist_keys[side][row][column];
+
+    for (int symmetry {0}; symmetry < 8; symmetry++)
+    {
+        int symmetric_point {symmetric_points[symmetry][row * 15 + column]};
+
+        ref_position.symmetric_keys[symmetry] ^= zobrist_keys[side][symmetric_point / 15][symmetric_point % 15];
+    }
+
+    update_line_values(ref_position, row, column);
+    update_frontier(ref_position, row, column, -1);
+
+    return;
+}
+
+
+/*
+<Summary> :: places a stone as the last move of a specified bitboard position, and pushes the previous last move to its undo stack so that unmake_move restores the position exactly
+<Parameter "ref_position"> :: a reference to the bitboard position where the stone is placed
+<Parameter "row"> :: the row index of the empty point
+<Parameter "column"> :: the column index of the empty point
+<Parameter "stone"> :: the stone to be placed (1 = player's stone, -1 = AI's stone)
+<Return> :: none
+*/
+void make_move(bitboard_position &ref_position, int row, int column, int stone)
+{
+    ref_position.undo_moves[ref_position.total_stones] = ref_position.last_placed_row == -1 ? 255 : static_cast<unsigned char>(ref_position.last_placed_row * 15 + ref_position.last_placed_column);
+
+    place_stone(ref_position, row, column, stone);
+    ref_position.last_placed_row = row;
+    ref_position.last_placed_column = column;
+
+    return;
+}
+
+
+/*
+<Summary> :: removes the last move of a specified bitboard position, which must have been placed by make_move, and pops the move before it from the undo stack
+<Parameter "ref_position"> :: a reference to the bitboard position where the last move is removed
+<Return> :: none
+*/
+void unmake_move(bitboard_position &ref_position)
+{
+    int previous_move;
+
+    remove_stone(ref_position, ref_position.last_placed_row, ref_position.last_placed_column);
+
+    previous_move = ref_position.undo_moves[ref_position.total_stones];
+    ref_position.last_placed_row = previous_move == 255 ? -1 : previous_move / 15;
+    ref_position.last_placed_column = previous_move == 255 ? -1 : previous_move % 15;
+
+    return;
+}
+
+
+/*
+<Summary> :: reads the stone on a specified point of a bitboard position
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "row"> :: the row index of the point
+<Parameter "column"> :: the column index of the point
+<Return> :: the stone on the point (1 = player's stone, -1 = AI's stone), or 0 if the point is empty
+*/
+int get_stone(const bitboard_position &ref_position, int row, int column)
+{
+    if ((ref_position.row_masks[0][row] >> column) & 1)
+        return 1;
+
+    if ((ref_position.row_masks[1][row] >> column) & 1)
+        return -1;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: reassesses the four lines passing through a specified point after a stone is placed on or removed from it, and updates the total line value of a bitboard position
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "row"> :: the row index of the changed point
+<Parameter "column"> :: the column index of the changed point
+<Return> :: none
+*/
+void update_line_values(bitboard_position &ref_position, int row, int column)
+{
+    long long &ref_row_value {ref_position.row_values[row]};
+    long long &ref_column_value {ref_position.column_values[column]};
+    long long &ref_major_diagonal_value {ref_position.major_diagonal_values[column - row + 14]};
+    long long &ref_minor_diagonal_value {ref_position.minor_diagonal_values[row + column]};
+
+    ref_position.total_line_value -= ref_row_value + ref_column_value + ref_major_diagonal_value + ref_minor_diagonal_value;
+
+    // only the stones within four points of the changed point can change their values, but a whole line is cheap enough to reassess with bit masks
+    ref_row_value = assess_line_value(ref_position.row_masks[0][row], ref_position.row_masks[1][row], ~0x7FFFu);
+    ref_column_value = assess_line_value(ref_position.column_masks[0][column], ref_position.column_masks[1][column], ~0x7FFFu);
+    ref_major_diagonal_value = assess_line_value(ref_position.major_diagonal_masks[0][column - row + 14], ref_position.major_diagonal_masks[1][column - row + 14], ~get_diagonal_mask(column - row + 14));
+    ref_minor_diagonal_value = assess_line_value(ref_position.minor_diagonal_masks[0][row + column], ref_position.minor_diagonal_masks[1][row + column], ~get_diagonal_mask(row + column));
+
+    ref_position.total_line_value += ref_row_value + ref_column_value + ref_major_diagonal_value + ref_minor_diagonal_value;
+
+    return;
+}
+
+
+/*
+<Summary> :: updates the neighbor counts around a specified point after a stone is placed on or removed from it, and adds or removes the affected empty points of the frontier
+<Parameter "ref_position"> :: a reference to the bitboard position, whose line masks already include the change
+<Parameter "row"> :: the row index of the changed point
+<Parameter "column"> :: the column index of the changed point
+<Parameter "count_change"> :: 1 if a stone is placed on the point, or -1 if a stone is removed from it
+<Return> :: none
+*/
+void update_frontier(bitboard_position &ref_position, int row, int column, int count_change)
+{
+    int radius {ref_position.frontier_radius};
+    int changed_move {row * 15 + column};
+
+    for (int nearby_row {row - radius > 0 ? row - radius : 0}; nearby_row <= row + radius && nearby_row <= 14; nearby_row++)
+    {
+        unsigned int occupied_mask {static_cast<unsigned int>(ref_position.row_masks[0][nearby_row] | ref_position.row_masks[1][nearby_row])};
+
+        // an empty point joins the frontier when its first nearby stone is placed, and leaves it when its last nearby stone is removed
+        // the counts are checked before the occupation, since most counts neither start from zero nor drop to zero
+        for (int nearby_column {column - radius > 0 ? column - radius : 0}; nearby_column <= column + radius && nearby_column <= 14; nearby_column++)
+        {
+            int move {nearby_row * 15 + nearby_column};
+
+            if (count_change > 0)
+            {
+                if (++ref_position.neighbor_counts[move] == 1 && move != changed_move && !((occupied_mask >> nearby_column) & 1))
+                    add_frontier_move(ref_position, move);
+            }
+            else
+            {
+                if (--ref_position.neighbor_counts[move] == 0 && ref_position.frontier_indexes[move] != 255)
+                    remove_frontier_move(ref_position, move);
+            }
+        }
+    }
+
+    // an occupied point is never a candidate move, but an emptied point is one as long as other stones remain nearby
+    if (count_change > 0 && ref_position.frontier_indexes[changed_move] != 255)
+        remove_frontier_move(ref_position, changed_move);
+    else if (count_change < 0 && ref_position.neighbor_counts[changed_move] > 0)
+        add_frontier_move(ref_position, changed_move);
+
+    return;
+}
+
+
+/*
+<Summary> :: appends an empty point to the end of the frontier list
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "move"> :: the empty point encoded as (row * 15 + column), which must not be in the frontier
+<Return> :: none
+*/
+void add_frontier_move(bitboard_position &ref_position, int move)
+{
+    ref_position.frontier_indexes[move] = static_cast<unsigned char>(ref_position.total_frontier_moves);
+    ref_position.frontier_moves[ref_position.total_frontier_moves++] = static_cast<unsigned char>(move);
+
+    return;
+}
+
+
+/*
+<Summary> :: removes a point from the frontier list by moving the last point of the list into its place
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "move"> :: the point encoded as (row * 15 + column), which must be in the frontier
+<Return> :: none
+*/
+void remove_frontier_move(bitboard_position &ref_position, int move)
+{
+    int index {ref_position.frontier_indexes[move]};
+    int last_move {ref_position.frontier_moves[--ref_position.total_frontier_moves]};
+
+    ref_position.frontier_moves[index] = static_cast<unsigned char>(last_move);
+    ref_position.frontier_indexes[last_move] = static_cast<unsigned char>(index);
+    ref_position.frontier_indexes[move] = 255;
+
+    return;
+}
+
+
+/*
+<Summary> :: lists the empty points of the frontier as the candidate moves of a bitboard position
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "moves"> :: an array storing the candidate moves, where each move is encoded as (row * 15 + column)
+<Return> :: the number of candidate moves
+*/
+int generate_candidate_moves(const bitboard_position &ref_position, int moves[225])
+{
+    for (int index {0}; index < ref_position.total_frontier_moves; index++)
+        moves[index] = ref_position.frontier_moves[index];
+
+    return ref_position.total_frontier_moves;
+}
+
+
+/*
+<Summary> :: sorts a move list so that the moves most likely to be the best are searched first, which lets alpha-beta pruning cut off more branches
+<Parameter "ref_context"> :: a reference to the search context, whose position is the position before the moves
+<Parameter "moves"> :: an array storing the move list, where each move is encoded as (row * 15 + column)
+<Parameter "total_moves"> :: the number of moves in the move list
+<Parameter "side"> :: the side to move (0 = player, 1 = AI)
+<Parameter "best_move"> :: the best move stored in the transposition table, or -1 if there is no such move
+<Return> :: none
+*/
+void order_candidate_moves(search_context &ref_context, int moves[], int total_moves, int side, int best_move)
+{
+    int ply {ref_context.position.total_stones - ref_context.root_total_stones};
+    long long move_scores[225];
+
+    // the best move comes first, the killer moves of the same ply come next, and the other moves are ordered by their static scores and history scores
+    for (int index {0}; index < total_moves; index++)
+    {
+        int move {moves[index]};
+
+        if (move == best_move)
+            move_scores[index] = 3000000000000LL;
+        else if (move == ref_context.killer_moves[ply][0])
+            move_scores[index] = 2000000000000LL;
+        else if (move == ref_context.killer_moves[ply][1])
+            move_scores[index] = 1000000000000LL;
+        else
+            move_scores[index] = score_candidate_move(ref_context.position, move / 15, move % 15, side) + ref_context.history_scores[side][move];
+    }
+
+    // sorts the moves by insertion sort, which is fast for short lists and keeps the frontier order of equal scores
+    for (int index {1}; index < total_moves; index++)
+    {
+        int move {moves[index]};
+        long long move_score {move_scores[index]};
+        int insert_index {index};
+
+        for (; insert_index > 0 && move_scores[insert_index - 1] < move_score; insert_index--)
+        {
+            moves[insert_index] = moves[insert_index - 1];
+            move_scores[insert_index] = move_scores[insert_index - 1];
+        }
+
+        moves[insert_index] = move;
+        move_scores[insert_index] = move_score;
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: scores a candidate move by the line patterns that it would form for the side to move and the line patterns of the opponent that it would block
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "row"> :: the row index of the empty point
+<Parameter "column"> :: the column index of the empty point
+<Parameter "side"> :: the side to move (0 = player, 1 = AI)
+<Return> :: the static score of the candidate move
+*/
+long long score_candidate_move(const bitboard_position &ref_position, int row, int column, int side)
+{
+    unsigned int own_masks[4] {ref_position.row_masks[side][row], ref_position.column_masks[side][column], ref_position.major_diagonal_masks[side][column - row + 14], ref_position.minor_diagonal_masks[side][row + column]};
+    unsigned int opponent_masks[4] {ref_position.row_masks[1 - side][row], ref_position.column_masks[1 - side][column], ref_position.major_diagonal_masks[1 - side][column - row + 14], ref_position.minor_diagonal_masks[1 - side][row + column]};
+    unsigned int edge_masks[4] {~0x7FFFu, ~0x7FFFu, ~get_diagonal_mask(column - row + 14), ~get_diagonal_mask(row + column)};
+    int bits[4] {column, row, column, column};
+    long long move_score {0};
+
+    // the pattern index of an empty point is the same as that of a stone placed on it, since the middle point is dropped from the index
+    for (int line {0}; line < 4; line++)
+        move_score += pattern_values[get_pattern_index(own_masks[line], opponent_masks[line], edge_masks[line], bits[line])] + pattern_values[get_pattern_index(opponent_masks[line], own_masks[line], edge_masks[line], bits[line])];
+
+    return move_score;
+}
+
+
+/*
+<Summary> :: records a move that causes an alpha-beta cutoff as a killer move of its ply, raises its history score, and counts the cutoff for the move ordering statistics
+<Parameter "ref_context"> :: a reference to the search context, whose position is the position before the move
+<Parameter "move"> :: the move causing the cutoff, encoded as (row * 15 + column)
+<Parameter "side"> :: the side making the move (0 = player, 1 = AI)
+<Parameter "search_depth"> :: the remaining search depth of the node
+<Parameter "move_index"> :: the index of the move in the ordered move list
+<Return> :: none
+*/
+void record_cutoff_move(search_context &ref_context, int move, int side, int search_depth, int move_index)
+{
+    int ply {ref_context.position.total_stones - ref_context.root_total_stones};
+
+    ref_context.counters.cutoffs_by_index[move_index < 7 ? move_index : 7]++;
+
+    if (ref_context.killer_moves[ply][0] != move)
+    {
+        ref_context.killer_moves[ply][1] = ref_context.killer_moves[ply][0];
+        ref_context.killer_moves[ply][0] = move;
+    }
+
+    // deeper cutoffs save more nodes, so they raise the history score more, which is scaled like the pattern values that it is added to
+    ref_context.history_scores[side][move] += search_depth * search_depth * 10;
+
+    return;
+}
+
+
+/*
+<Summary> :: predicts the board value using the minimax algorithm with alpha-beta pruning
+<Parameter "ref_context"> :: a reference to the search context, whose position is searched
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "search_depth"> :: the number of moves to be predicted
+<Parameter "max_board_value"> :: the maximum board value that the AI has found
+<Parameter "min_board_value"> :: the minimum board value that the player has found
+<Return> :: the predicted board value, which is meaningless if the search is aborted
+*/
+int predict_board_value(search_context &ref_context, bool is_player_next, int search_depth, int max_board_value, int min_board_value)
+{
+    bitboard_position &ref_position {ref_context.position};
+    int original_max_board_value {max_board_value};
+    int original_min_board_value {min_board_value};
+    int ply {ref_position.total_stones - ref_context.root_total_stones};
+    unsigned long long search_key;
+    int symmetry;
+    int moves[225];
+    int total_moves;
+    int best_move;
+    int stored_value;
+    std::chrono::steady_clock::time_point part_start_time;
+
+    // checks the time and node budgets once every 1024 nodes, since reading the clock is relatively slow
+    ref_context.total_nodes++;
+    if ((ref_context.total_nodes & 1023) == 0)
+        check_search_limits(ref_context);
+
+    if (ref_context.is_aborted)
+        return 0;
+
+    // returns the board value if a leaf node of recursion tree is found
+    if (assess_leaf_node(ref_context, is_player_next, search_depth, stored_value))
+        return stored_value;
+
+    // returns the stored board value if the same position, or any rotation or reflection of it, has been searched deeply enough in any move order
+    search_key = get_search_key(ref_position, is_player_next, symmetry);
+    ref_context.counters.table_probes++;
+    if (probe_transposition_table(*ref_context.p_table, search_key, symmetry, ply, search_depth, ref_context.total_split_threads > 0, max_board_value, min_board_value, stored_value, best_move))
+    {
+        ref_context.counters.table_hits++;
+        return stored_value;
+    }
+
+    if (ref_context.is_timed)
+        part_start_time = std::chrono::steady_clock::now();
+
+    total_moves = generate_candidate_moves(ref_position, moves);
+    order_candidate_moves(ref_context, moves, total_moves, is_player_next ? 0 : 1, best_move);
+
+    if (ref_context.is_timed)
+        ref_context.counters.move_generation_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+    for (int index {0}; index < total_moves; index++)
+    {
+        int row {moves[index] / 15};
+        int column {moves[index] % 15};
+        int board_value;
+
+        if (ref_context.is_timed)
+            part_start_time = std::chrono::steady_clock::now();
+
+        make_move(ref_position, row, column, is_player_next ? 1 : -1);
+
+        if (ref_context.is_timed)
+            ref_context.counters.stone_update_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+        board_value = predict_board_value(ref_context, !is_player_next, search_depth - 1, max_board_value, min_board_value);
+
+        if (ref_context.is_timed)
+            part_start_time = std::chrono::steady_clock::now();
+
+        unmake_move(ref_position);
+
+        if (ref_context.is_timed)
+            ref_context.counters.stone_update_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+        // leaves the transposition table untouched, since the values of an aborted search are incomplete
+        if (ref_context.is_aborted)
+            return 0;
+
+        // calculates the minimum board value for the player turn, or the maximum board value for the AI turn
+        if (is_player_next && board_value < min_board_value)
+        {
+            min_board_value = board_value;
+            best_move = moves[index];
+        }
+        else if (!is_player_next && board_value > max_board_value)
+        {
+            max_board_value = board_value;
+            best_move = moves[index];
+        }
+
+        if (min_board_value <= max_board_value)
+        {
+            record_cutoff_move(ref_context, moves[index], is_player_next ? 0 : 1, search_depth, index);
+            break;
+        }
+    }
+
+    stored_value = is_player_next ? min_board_value : max_board_value;
+    store_transposition_table(*ref_context.p_table, search_key, symmetry, ply, search_depth, stored_value, original_max_board_value, original_min_board_value, best_move);
+
+    return stored_value;
+}
+
+
+/*
+<Summary> :: predicts the value of the side to move using the negamax form of the principal variation search (NegaScout), which searches the first move with the full window and proves with a null window that each later move is no better
+the late quiet moves are searched one move shallower, and the quiet moves near the full depth are skipped if the static board value is far below alpha, if the search context enables it
+<Parameter "ref_context"> :: a reference to the search context, whose position is searched
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "search_depth"> :: the number of moves to be predicted
+<Parameter "alpha"> :: the value that the side to move has already secured elsewhere, from its own point of view
+<Parameter "beta"> :: the value that the opponent has already secured elsewhere, from the point of view of the side to move
+<Return> :: the predicted board value from the point of view of the side to move, which is only a bound if it falls outside the window, and meaningless if the search is aborted
+*/
+int search_principal_variation(search_context &ref_context, bool is_player_next, int search_depth, int alpha, int beta)
+{
+    bitboard_position &ref_position {ref_context.position};
+    // the sign that turns a board value into the value of the side to move
+    int side_sign {is_player_next ? -1 : 1};
+    int original_alpha {alpha};
+    int ply {ref_position.total_stones - ref_context.root_total_stones};
+    unsigned long long search_key;
+    int symmetry;
+    int moves[225];
+    int total_moves;
+    int best_move;
+    int best_value {-infinite_board_value};
+    int stored_value;
+    // the static value of the side to move plus the futility margin, which is the most that a quiet move is expected to reach, or the lowest value if no move is pruned
+    int futility_value {-infinite_board_value};
+    // the points of the moves that make or stop a four or a five, which are never reduced or pruned, and are only found once a move needs them
+    bool tactical_points[225];
+    bool is_tactical_found {false};
+    std::chrono::steady_clock::time_point part_start_time;
+
+    // plays out the fours at the full depth instead of assessing a position that is about to change, which avoids the blunders just beyond the horizon
+    if (search_depth == 0 && ref_context.max_quiescence_depth > 0)
+        return search_quiescence(ref_context, is_player_next, ref_context.max_quiescence_depth, alpha, beta);
+
+    // checks the time and node budgets once every 1024 nodes, since reading the clock is relatively slow
+    ref_context.total_nodes++;
+    if ((ref_context.total_nodes & 1023) == 0)
+        check_search_limits(ref_context);
+
+    if (ref_context.is_aborted)
+        return 0;
+
+    if (assess_leaf_node(ref_context, is_player_next, search_depth, stored_value))
+        return side_sign * stored_value;
+
+    // the transposition table holds board values, so the window is turned back into the maximum and minimum board values, which the two search variants share
+    search_key = get_search_key(ref_position, is_player_next, symmetry);
+    ref_context.counters.table_probes++;
+    if (probe_transposition_table(*ref_context.p_table, search_key, symmetry, ply, search_depth, ref_context.total_split_threads > 0, is_player_next ? -beta : alpha, is_player_next ? -alpha : beta, stored_value, best_move))
+    {
+        ref_context.counters.table_hits++;
+        return side_sign * stored_value;
+    }
+
+    if (ref_context.is_timed)
+        part_start_time = std::chrono::steady_clock::now();
+
+    total_moves = generate_candidate_moves(ref_position, moves);
+    order_candidate_moves(ref_context, moves, total_moves, is_player_next ? 0 : 1, best_move);
+
+    if (ref_context.is_timed)
+        ref_context.counters.move_generation_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+    // a quiet move in the last two moves can only raise the static value by about the margin per move, so it cannot raise alpha if the static value is far below it
+    if (ref_context.futility_margin > 0 && search_depth <= 2 && original_alpha > -max_assessed_value && original_alpha < max_assessed_value)
+    {
+        int static_value {side_sign * assess_board_value(ref_position)};
+
+        if (static_value + ref_context.futility_margin * search_depth <= alpha)
+            futility_value = static_value + ref_context.futility_margin * search_depth;
+    }
+
+    for (int index {0}; index < total_moves; index++)
+    {
+        int row {moves[index] / 15};
+        int column {moves[index] % 15};
+        int move_value;
+        // the number of moves by which the null-window search of the move is reduced
+        int reduction {0};
+
+        if ((futility_value != -infinite_board_value || (ref_context.is_late_move_reduction_enabled && index >= 3 && search_depth >= 3)) && !is_tactical_found)
+        {
+            find_tactical_points(ref_position, tactical_points);
+            is_tactical_found = true;
+        }
+
+        // skips a quiet move that cannot raise alpha, and keeps the futility value as the bound of its value
+        if (futility_value != -infinite_board_value && !tactical_points[moves[index]])
+        {
+            ref_context.counters.futility_prunes++;
+            best_value = std::max(best_value, futility_value);
+            continue;
+        }
+
+        // reduces the quiet moves after the first three, which are rarely the best once the moves are ordered
+        if (ref_context.is_late_move_reduction_enabled && index >= 3 && search_depth >= 3 && !tactical_points[moves[index]])
+            reduction = 1;
+
+        if (ref_context.is_timed)
+            part_start_time = std::chrono::steady_clock::now();
+
+        make_move(ref_position, row, column, is_player_next ? 1 : -1);
+
+        if (ref_context.is_timed)
+            ref_context.counters.stone_update_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+        // searches the first move with the full window, and every later move with a null window that only tells whether it beats alpha
+        // a later move beating alpha is searched again without its reduction and then with the full window, which is rare if the moves are well ordered
+        if (index == 0)
+        {
+            move_value = -search_principal_variation(ref_context, !is_player_next, search_depth - 1, -beta, -alpha);
+        }
+        else
+        {
+            move_value = -search_principal_variation(ref_context, !is_player_next, search_depth - 1 - reduction, -alpha - 1, -alpha);
+            ref_context.counters.reduced_moves += reduction;
+
+            if (reduction > 0 && move_value > alpha)
+            {
+                ref_context.counters.reduction_researches++;
+                move_value = -search_principal_variation(ref_context, !is_player_next, search_depth - 1, -alpha - 1, -alpha);
+            }
+
+            if (move_value > alpha && move_value < beta)
+                move_value = -search_principal_variation(ref_context, !is_player_next, search_depth - 1, -beta, -alpha);
+        }
+
+        if (ref_context.is_timed)
+            part_start_time = std::chrono::steady_clock::now();
+
+        unmake_move(ref_position);
+
+        if (ref_context.is_timed)
+            ref_context.counters.stone_update_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+        // leaves the transposition table untouched, since the values of an aborted search are incomplete
+        if (ref_context.is_aborted)
+            return 0;
+
+        if (move_value > best_value)
+            best_value = move_value;
+
+        if (move_value > alpha)
+        {
+            alpha = move_value;
+            best_move = moves[index];
+        }
+
+        if (alpha >= beta)
+        {
+            record_cutoff_move(ref_context, moves[index], is_player_next ? 0 : 1, search_depth, index);
+            break;
+        }
+    }
+
+    store_transposition_table(*ref_context.p_table, search_key, symmetry, ply, search_depth, side_sign * best_value, is_player_next ? -beta : original_alpha, is_player_next ? -original_alpha : beta, best_move);
+
+    return best_value;
+}
+
+
+/*
+<Summary> :: searches only the forcing moves after the full depth until the position is quiet, where the side to move blocks the opponent's four if it must, and otherwise either stands on the board value or makes a four of its own
+<Parameter "ref_context"> :: a reference to the search context, whose position is searched
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "remaining_depth"> :: the number of moves that may still be searched, after which the board value is assessed even if the position is not quiet
+<Parameter "alpha"> :: the value that the side to move has already secured elsewhere, from its own point of view
+<Parameter "beta"> :: the value that the opponent has already secured elsewhere, from the point of view of the side to move
+<Return> :: the predicted board value from the point of view of the side to move, which is only a bound if it falls outside the window, and meaningless if the search is aborted
+*/
+int search_quiescence(search_context &ref_context, bool is_player_next, int remaining_depth, int alpha, int beta)
+{
+    bitboard_position &ref_position {ref_context.position};
+    // the sign that turns a board value into the value of the side to move
+    int side_sign {is_player_next ? -1 : 1};
+    int side {is_player_next ? 0 : 1};
+    int ply {ref_position.total_stones - ref_context.root_total_stones};
+    int moves[225];
+    int total_moves;
+    int best_value;
+    int leaf_value;
+
+    // checks the time and node budgets once every 1024 nodes, since reading the clock is relatively slow
+    ref_context.total_nodes++;
+    ref_context.counters.quiescence_nodes++;
+    if ((ref_context.total_nodes & 1023) == 0)
+        check_search_limits(ref_context);
+
+    if (ref_context.is_aborted)
+        return 0;
+
+    // returns the value of a decided battle, or the board value once no more moves may be searched
+    if (assess_leaf_node(ref_context, is_player_next, remaining_depth, leaf_value))
+        return side_sign * leaf_value;
+
+    // wins with the next move if the side to move has a four
+    if (find_threat_points(ref_position, side, 4, moves) > 0)
+        return win_board_value - (ply + 1);
+
+    // must block the opponent's four, where the board value is no option since the opponent wins otherwise
+    total_moves = find_threat_points(ref_position, 1 - side, 4, moves);
+    best_value = -infinite_board_value;
+
+    if (total_moves == 0)
+    {
+        // may stand on the board value of a quiet position, or make a four to force the opponent's reply
+        best_value = side_sign * assess_board_value(ref_position);
+
+        if (best_value >= beta)
+            return best_value;
+
+        alpha = std::max(alpha, best_value);
+        total_moves = find_threat_points(ref_position, side, 3, moves);
+    }
+
+    for (int index {0}; index < total_moves; index++)
+    {
+        int row {moves[index] / 15};
+        int column {moves[index] % 15};
+        int move_value;
+
+        make_move(ref_position, row, column, is_player_next ? 1 : -1);
+
+        move_value = -search_quiescence(ref_context, !is_player_next, remaining_depth - 1, -beta, -alpha);
+
+        unmake_move(ref_position);
+
+        if (ref_context.is_aborted)
+            return 0;
+
+        best_value = std::max(best_value, move_value);
+        alpha = std::max(alpha, move_value);
+
+        if (alpha >= beta)
+            break;
+    }
+
+    return best_value;
+}
+
+
+/*
+<Summary> :: checks whether a node of the search is a leaf, which is a decided battle or a node at the full depth, and assesses the board value of a leaf
+<Parameter "ref_context"> :: a reference to the search context, whose position is checked
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "search_depth"> :: the number of moves to be predicted from the node
+<Parameter "ref_board_value"> :: a reference to the variable storing the board value of a leaf
+<Return> :: whether the node is a leaf
+*/
+bool assess_leaf_node(search_context &ref_context, bool is_player_next, int search_depth, int &ref_board_value)
+{
+    const bitboard_position &ref_position {ref_context.position};
+    int ply {ref_position.total_stones - ref_context.root_total_stones};
+    bool is_leaf {true};
+    std::chrono::steady_clock::time_point part_start_time;
+
+    if (ref_context.is_timed)
+        part_start_time = std::chrono::steady_clock::now();
+
+    // gives the value of the win or the tie if the battle is over, or the current board value at the full depth
+    // the battle state is checked at the full depth as well, so that a win on the last predicted move is never assessed as an ordinary position
+    ref_context.counters.battle_state_checks++;
+    if (check_last_move_five(ref_position))
+        ref_board_value = is_player_next ? win_board_value - ply : ply - win_board_value;
+    else if (ref_position.total_stones == 225)
+        ref_board_value = 0;
+    else if (search_depth == 0)
+        ref_board_value = assess_board_value(ref_position);
+    else
+        is_leaf = false;
+
+    if (ref_context.is_timed)
+        ref_context.counters.evaluation_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - part_start_time).count();
+
+    if (is_leaf)
+        ref_context.counters.leaf_evaluations++;
+
+    return is_leaf;
+}
+
+
+/*
+<Summary> :: marks the points where either side makes a four or a five, which also are the points where the other side stops it, so that the search never reduces or prunes these moves
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "tactical_points"> :: an array storing whether each point is tactical, indexed by (row * 15 + column)
+<Return> :: none
+*/
+void find_tactical_points(const bitboard_position &ref_position, bool tactical_points[225])
+{
+    int points[225];
+
+    std::fill(tactical_points, tactical_points + 225, false);
+
+    for (int side {0}; side < 2; side++)
+    {
+        for (int required_stones {3}; required_stones <= 4; required_stones++)
+        {
+            int total_points {find_threat_points(ref_position, side, required_stones, points)};
+
+            for (int index {0}; index < total_points; index++)
+                tactical_points[points[index]] = true;
+        }
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: searches the AI's best move with the Monte Carlo tree search, which grows a tree of the promising moves by random playouts on every search thread until the time or node budget runs out, and stores the most visited root move to the search context
+<Parameter "ref_context"> :: a reference to the search context, whose root moves have been generated and whose node count is the number of playouts
+<Parameter "ref_settings"> :: a reference to the settings containing the time, node, and rollout budgets
+<Parameter "ref_tree"> :: a reference to the search tree, which keeps the subtree of the position from the previous AI move if the position is found there
+<Parameter "ref_helper_contexts"> :: a reference to the copies of the search context for the helper threads, which share the tree with the main thread
+<Parameter "ref_stop_signal"> :: a reference to the signal that stops the helper threads
+<Parameter "ref_win_rate"> :: a reference to the variable storing the ratio of the playouts won through the best move
+<Return> :: none
+*/
+void search_monte_carlo(search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, std::vector<search_context> &ref_helper_contexts, std::atomic<bool> &ref_stop_signal, double &ref_win_rate)
+{
+    std::vector<std::thread> helper_threads;
+    const mcts_node *p_root;
+    int best_child;
+
+    // allocates the arena at the first search, so that the AI never holds it unless it searches with the Monte Carlo tree search
+    if (ref_tree.nodes.empty())
+        std::vector<mcts_node>(ref_tree.total_arena_nodes).swap(ref_tree.nodes);
+
+    // keeps the subtree of the position if the previous search reached it and the arena has room for it to grow, and starts a new tree otherwise
+    if (ref_tree.total_used_nodes.load(std::memory_order_relaxed) * 2 > static_cast<int>(ref_tree.nodes.size()) || !reuse_mcts_tree(ref_tree, ref_context.position))
+        reset_mcts_tree(ref_tree, ref_context.position);
+
+    // the children of the root must be the root moves, which may have been narrowed down to the defenses against a forced win of the player
+    p_root = &ref_tree.nodes[ref_tree.root_index];
+    if (p_root->first_child.load(std::memory_order_relaxed) != -1 && p_root->total_children != ref_context.total_root_moves)
+        reset_mcts_tree(ref_tree, ref_context.position);
+
+    p_root = &ref_tree.nodes[ref_tree.root_index];
+    if (p_root->first_child.load(std::memory_order_relaxed) == -1 && !expand_mcts_node(ref_tree, ref_tree.root_index, ref_context.position, 1, ref_context.root_moves, ref_context.total_root_moves))
+        return;
+
+    ref_tree.total_playouts.store(0, std::memory_order_relaxed);
+
+    // gives every helper thread its own copy of the position and its own random engine, while all threads descend the same tree
+    for (int index {0}; index < static_cast<int>(ref_helper_contexts.size()); index++)
+        helper_threads.emplace_back(run_mcts_playouts, std::ref(ref_helper_contexts[index]), std::cref(ref_settings), std::ref(ref_tree), static_cast<unsigned int>(ref_tree.random_engine()), false);
+
+    run_mcts_playouts(ref_context, ref_settings, ref_tree, static_cast<unsigned int>(ref_tree.random_engine()), true);
+
+    // stops the helper threads as soon as the main thread runs out of its budget
+    ref_stop_signal.store(true, std::memory_order_relaxed);
+
+    for (std::thread &ref_thread : helper_threads)
+        ref_thread.join();
+
+    // plays the most visited move, which is more reliable than the move with the best win rate
+    best_child = p_root->first_child.load(std::memory_order_relaxed);
+
+    for (int child {best_child + 1}; child < p_root->first_child.load(std::memory_order_relaxed) + p_root->total_children; child++)
+        if (ref_tree.nodes[child].total_visits.load(std::memory_order_relaxed) > ref_tree.nodes[best_child].total_visits.load(std::memory_order_relaxed))
+            best_child = child;
+
+    ref_context.best_move = ref_tree.nodes[best_child].move;
+    ref_win_rate = ref_tree.nodes[best_child].total_visits.load(std::memory_order_relaxed) > 0 ? ref_tree.nodes[best_child].total_results.load(std::memory_order_relaxed) / (2.0 * ref_tree.nodes[best_child].total_visits.load(std::memory_order_relaxed)) : 0.0;
+
+    // reports the length of the most visited line as the completed depth
+    for (int node_index {best_child}; ref_tree.nodes[node_index].first_child.load(std::memory_order_relaxed) >= 0; ref_context.completed_depth++)
+    {
+        const mcts_node &ref_node {ref_tree.nodes[node_index]};
+        int first_child {ref_node.first_child.load(std::memory_order_relaxed)};
+
+        node_index = first_child;
+        for (int child {first_child + 1}; child < first_child + ref_node.total_children; child++)
+            if (ref_tree.nodes[child].total_visits.load(std::memory_order_relaxed) > ref_tree.nodes[node_index].total_visits.load(std::memory_order_relaxed))
+                node_index = child;
+
+        if (ref_tree.nodes[node_index].total_visits.load(std::memory_order_relaxed) == 0)
+            break;
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: runs playouts of the Monte Carlo tree search on one thread until the search is aborted, where the main thread checks the time budget, every thread checks the node budget against the playouts of all threads, and the helper threads otherwise wait for the stop signal
+<Parameter "ref_context"> :: a reference to the search context of the thread
+<Parameter "ref_settings"> :: a reference to the settings containing the rollout budget
+<Parameter "ref_tree"> :: a reference to the search tree shared by all threads
+<Parameter "random_seed"> :: the seed of the random engine of the thread, which is drawn from the engine of the tree so that a search on one thread repeats itself
+<Parameter "is_main_thread"> :: whether the playouts run on the main thread
+<Return> :: none
+*/
+void run_mcts_playouts(search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, unsigned int random_seed, bool is_main_thread)
+{
+    std::mt19937 random_engine {random_seed};
+
+    // plays until the budget runs out, where the first playout of the main thread completes the first iteration so that the search limits apply afterwards
+    while (!ref_context.is_aborted)
+    {
+        long long total_playouts;
+
+        run_mcts_playout(ref_context, ref_settings, ref_tree, random_engine);
+        total_playouts = ref_tree.total_playouts.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        ref_context.total_nodes++;
+        if (is_main_thread)
+            ref_context.completed_depth = 1;
+
+        // stops after the same number of playouts on any number of threads, so that the node budget counts the work of the whole search
+        if (ref_context.node_budget > 0 && total_playouts >= ref_context.node_budget)
+            ref_context.is_aborted = true;
+
+        if ((ref_context.total_nodes & 15) == 0)
+            check_search_limits(ref_context);
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: runs one playout of the Monte Carlo tree search, which descends the tree by the upper confidence bounds, expands the reached node, plays a random game from it, and adds the result to every node on the way
+each node on the way counts the visit at once and the result only at the end, so that the playouts of the other threads see a virtual loss and turn to different children
+<Parameter "ref_context"> :: a reference to the search context, whose position is the root position of the tree
+<Parameter "ref_settings"> :: a reference to the settings containing the rollout budget
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "ref_random_engine"> :: a reference to the random engine of the thread
+<Return> :: none
+*/
+void run_mcts_playout(const search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, std::mt19937 &ref_random_engine)
+{
+    // the playout changes a copy of the root position, which is cheaper than removing every stone of the random game afterwards
+    bitboard_position position {ref_context.position};
+    int path[226];
+    int path_length {0};
+    int node_index {ref_tree.root_index};
+    int previous_visits;
+    bool is_player_next {false};
+    bool is_decided {false};
+    // the side that wins the playout (0 = player, 1 = AI), or -1 for a tie
+    int winner {-1};
+
+    path[path_length++] = node_index;
+    previous_visits = ref_tree.nodes[node_index].total_visits.fetch_add(1, std::memory_order_relaxed);
+
+    // descends until a node without children or a decided position, and expands a node that has been reached before
+    while (!is_decided)
+    {
+        int first_child {ref_tree.nodes[node_index].first_child.load(std::memory_order_acquire)};
+        int move;
+
+        // plays from a node that another thread is expanding, which is as good as waiting for its children
+        if (first_child < 0)
+        {
+            int moves[225];
+            int total_moves;
+
+            if (previous_visits == 0 || first_child == -2)
+                break;
+
+            total_moves = generate_candidate_moves(position, moves);
+            if (!expand_mcts_node(ref_tree, node_index, position, is_player_next ? 0 : 1, moves, total_moves))
+                break;
+        }
+
+        node_index = select_mcts_child(ref_tree, node_index);
+        move = ref_tree.nodes[node_index].move;
+        previous_visits = ref_tree.nodes[node_index].total_visits.fetch_add(1, std::memory_order_relaxed);
+
+        make_move(position, move / 15, move % 15, is_player_next ? 1 : -1);
+        path[path_length++] = node_index;
+        is_player_next = !is_player_next;
+
+        if (check_battle_state(position))
+        {
+            is_decided = true;
+            winner = check_last_move_five(position) ? (is_player_next ? 1 : 0) : -1;
+        }
+    }
+
+    if (!is_decided)
+        winner = play_mcts_rollout(position, is_player_next, ref_settings.max_rollout_depth, ref_random_engine);
+
+    // the root's move was made by the player, and the moves of the nodes below alternate from the AI
+    for (int index {0}; index < path_length; index++)
+        ref_tree.nodes[path[index]].total_results.fetch_add(winner == -1 ? 1 : (winner == index % 2 ? 2 : 0), std::memory_order_relaxed);
+
+    return;
+}
+
+
+/*
+<Summary> :: selects the child of a node with the highest upper confidence bound, where only the children with the best static scores are considered until the node has been visited often
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "node_index"> :: the index of the expanded node
+<Return> :: the index of the selected child
+*/
+int select_mcts_child(const mcts_tree &ref_tree, int node_index)
+{
+    const mcts_node &ref_node {ref_tree.nodes[node_index]};
+    int first_child {ref_node.first_child.load(std::memory_order_acquire)};
+    int total_visits {ref_node.total_visits.load(std::memory_order_relaxed)};
+    // widens the considered children with the square root of the visits, since most of the candidate moves are rarely worth a playout
+    int total_candidates {std::min(static_cast<int>(ref_node.total_children), 2 + static_cast<int>(std::sqrt(static_cast<double>(total_visits))))};
+    double log_visits {std::log(total_visits + 1.0)};
+    int best_child {first_child};
+    double best_bound {-1.0};
+
+    for (int child {first_child}; child < first_child + total_candidates; child++)
+    {
+        const mcts_node &ref_child {ref_tree.nodes[child]};
+        int child_visits {ref_child.total_visits.load(std::memory_order_relaxed)};
+        double bound;
+
+        // plays every considered child once before comparing their bounds
+        if (child_visits == 0)
+            return child;
+
+        bound = ref_child.total_results.load(std::memory_order_relaxed) / (2.0 * child_visits) + mcts_exploration_weight * std::sqrt(log_visits / child_visits);
+
+        if (bound > best_bound)
+        {
+            best_bound = bound;
+            best_child = child;
+        }
+    }
+
+    return best_child;
+}
+
+
+/*
+<Summary> :: expands a node by allocating its children next to each other in the arena, ordered by the static scores of their moves
+the node is claimed before its children are allocated, so that threads reaching the node at the same time never expand it twice, and the children are published only after they are written
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "node_index"> :: the index of the node to be expanded
+<Parameter "ref_position"> :: a reference to the position of the node
+<Parameter "side"> :: the side to move at the node (0 = player, 1 = AI)
+<Parameter "moves"> :: an array storing the moves of the children
+<Parameter "total_moves"> :: the number of moves
+<Return> :: whether the node is expanded, which fails if the arena is full, there is no move, or another thread is expanding the node
+*/
+bool expand_mcts_node(mcts_tree &ref_tree, int node_index, const bitboard_position &ref_position, int side, const int moves[], int total_moves)
+{
+    long long move_scores[225];
+    int sorted_moves[225];
+    int expected_child {-1};
+    int first_child;
+
+    if (total_moves == 0 || ref_tree.total_used_nodes.load(std::memory_order_relaxed) + total_moves > static_cast<int>(ref_tree.nodes.size()))
+        return false;
+
+    if (!ref_tree.nodes[node_index].first_child.compare_exchange_strong(expected_child, -2, std::memory_order_relaxed))
+        return false;
+
+    // takes the children from the arena without a lock, and gives the node back if the arena has just run out
+    first_child = ref_tree.total_used_nodes.fetch_add(total_moves, std::memory_order_relaxed);
+    if (first_child + total_moves > static_cast<int>(ref_tree.nodes.size()))
+    {
+        ref_tree.nodes[node_index].first_child.store(-1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // sorts the moves by their static scores, which lets the progressive widening consider the strongest moves first
+    for (int index {0}; index < total_moves; index++)
+    {
+        long long move_score {score_candidate_move(ref_position, moves[index] / 15, moves[index] % 15, side)};
+        int insert_index {index};
+
+        for (; insert_index > 0 && move_scores[insert_index - 1] < move_score; insert_index--)
+        {
+            move_scores[insert_index] = move_scores[insert_index - 1];
+            sorted_moves[insert_index] = sorted_moves[insert_index - 1];
+        }
+
+        move_scores[insert_index] = move_score;
+        sorted_moves[insert_index] = moves[index];
+    }
+
+    for (int index {0}; index < total_moves; index++)
+    {
+        mcts_node &ref_child {ref_tree.nodes[first_child + index]};
+
+        ref_child.first_child.store(-1, std::memory_order_relaxed);
+        ref_child.total_visits.store(0, std::memory_order_relaxed);
+        ref_child.total_results.store(0, std::memory_order_relaxed);
+        ref_child.move = static_cast<unsigned char>(sorted_moves[index]);
+        ref_child.total_children = 0;
+    }
+
+    ref_tree.nodes[node_index].total_children = static_cast<unsigned char>(total_moves);
+    ref_tree.nodes[node_index].first_child.store(first_child, std::memory_order_release);
+
+    return true;
+}
+
+
+/*
+<Summary> :: plays a random game from a position, where each side wins at once if it can and blocks the opponent's five if it must, and otherwise plays a random move next to the stones
+<Parameter "ref_position"> :: a reference to the position, which is changed by the random moves
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "max_rollout_depth"> :: the number of random moves after which the game ends as a tie
+<Parameter "ref_random_engine"> :: a reference to the random engine
+<Return> :: the side that wins the game (0 = player, 1 = AI), or -1 for a tie
+*/
+int play_mcts_rollout(bitboard_position &ref_position, bool is_player_next, int max_rollout_depth, std::mt19937 &ref_random_engine)
+{
+    int points[225];
+
+    for (int ply {0}; ply < max_rollout_depth && ref_position.total_stones < 225; ply++)
+    {
+        int side {is_player_next ? 0 : 1};
+        int move;
+
+        // a side with four stones in a five-point window wins at once, so no five ever has to be looked for after a move
+        if (find_threat_points(ref_position, side, 4, points) > 0)
+            return side;
+
+        if (find_threat_points(ref_position, 1 - side, 4, points) > 0)
+            move = points[0];
+        else
+            move = ref_position.frontier_moves[std::uniform_int_distribution<int> {0, ref_position.total_frontier_moves - 1}(ref_random_engine)];
+
+        make_move(ref_position, move / 15, move % 15, is_player_next ? 1 : -1);
+        is_player_next = !is_player_next;
+    }
+
+    return -1;
+}
+
+
+/*
+<Summary> :: sets the arena size of a search tree and empties the tree, where the arena is allocated by the first search that uses the tree
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "total_nodes"> :: the number of nodes in the arena
+<Return> :: none
+*/
+void clear_mcts_tree(mcts_tree &ref_tree, int total_nodes)
+{
+    // keeps an allocated arena of the same size, since the nodes are written when they are taken from the arena, and releases it otherwise
+    if (static_cast<int>(ref_tree.nodes.size()) != total_nodes)
+        std::vector<mcts_node>().swap(ref_tree.nodes);
+
+    ref_tree.total_arena_nodes = total_nodes;
+
+    ref_tree.total_used_nodes.store(0, std::memory_order_relaxed);
+    ref_tree.total_playouts.store(0, std::memory_order_relaxed);
+    ref_tree.root_index = 0;
+    ref_tree.random_engine.seed(20240101);
+
+    return;
+}
+
+
+/*
+<Summary> :: starts a new tree with a single root node for a specified position, which discards every node in the arena
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "ref_position"> :: a reference to the position of the root, which has the AI to move
+<Return> :: none
+*/
+void reset_mcts_tree(mcts_tree &ref_tree, const bitboard_position &ref_position)
+{
+    ref_tree.nodes[0].first_child.store(-1, std::memory_order_relaxed);
+    ref_tree.nodes[0].total_visits.store(0, std::memory_order_relaxed);
+    ref_tree.nodes[0].total_results.store(0, std::memory_order_relaxed);
+    ref_tree.nodes[0].move = 255;
+    ref_tree.nodes[0].total_children = 0;
+    ref_tree.total_used_nodes.store(1, std::memory_order_relaxed);
+    ref_tree.root_index = 0;
+    ref_tree.root_position = ref_position;
+
+    return;
+}
+
+
+/*
+<Summary> :: moves the root of a search tree down to a position that follows the root position by the AI's move and the player's reply, so that their subtree keeps its playouts
+<Parameter "ref_tree"> :: a reference to the search tree
+<Parameter "ref_position"> :: a reference to the new position, which has the AI to move
+<Return> :: whether the position is found in the tree
+*/
+bool reuse_mcts_tree(mcts_tree &ref_tree, const bitboard_position &ref_position)
+{
+    int added_moves[2] {-1, -1};
+    int node_index {ref_tree.root_index};
+
+    if (ref_tree.total_used_nodes.load(std::memory_order_relaxed) == 0 || ref_position.total_stones != ref_tree.root_position.total_stones + 2)
+        return false;
+
+    // finds the two added stones, and fails if any stone of the root position is missing
+    for (int row {0}; row < 15; row++)
+    {
+        for (int side {0}; side < 2; side++)
+        {
+            unsigned int old_mask {ref_tree.root_position.row_masks[side][row]};
+            unsigned int new_mask {ref_position.row_masks[side][row]};
+
+            if (old_mask & ~new_mask)
+                return false;
+
+            for (int column {0}; (new_mask & ~old_mask) >> column; column++)
+            {
+                if (((new_mask & ~old_mask) >> column) & 1)
+                {
+                    if (added_moves[side] != -1)
+                        return false;
+
+                    added_moves[side] = row * 15 + column;
+                }
+            }
+        }
+    }
+
+    // follows the AI's move and then the player's reply
+    for (int side {1}; side >= 0; side--)
+    {
+        const mcts_node &ref_node {ref_tree.nodes[node_index]};
+        int first_child {ref_node.first_child.load(std::memory_order_relaxed)};
+        int child {first_child};
+
+        if (first_child < 0)
+            return false;
+
+        for (; child < first_child + ref_node.total_children && ref_tree.nodes[child].move != added_moves[side]; child++);
+
+        if (child == first_child + ref_node.total_children)
+            return false;
+
+        node_index = child;
+    }
+
+    ref_tree.root_index = node_index;
+    ref_tree.root_position = ref_position;
+
+    return true;
+}
+
+
+/*
+<Summary> :: gets the canonical key of a bitboard position together with the side to move, which lets the rotations and reflections of a position share their search results
+the plain Zobrist key is used instead if the pattern values are not mirror-symmetric, since the symmetric positions would then have different values
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "is_player_next"> :: whether the player moves next
+<Parameter "ref_symmetry"> :: a reference to the variable storing the symmetry that transforms the moves of the position into the moves of the stored entry
+<Return> :: the search key of the position
+*/
+unsigned long long get_search_key(const bitboard_position &ref_position, bool is_player_next, int &ref_symmetry)
+{
+    unsigned long long position_key;
+
+    if (is_pattern_symmetric)
+    {
+        position_key = get_canonical_key(ref_position, ref_symmetry);
+    }
+    else
+    {
+        position_key = ref_position.symmetric_keys[0];
+        ref_symmetry = 0;
+    }
+
+    return is_player_next ? position_key ^ zobrist_player_key : position_key;
+}
+
+
+/*
+<Summary> :: gets the canonical key of a bitboard position, which is the smallest of its symmetric keys, so that all eight rotations and reflections of the position have the same key
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Parameter "ref_symmetry"> :: a reference to the variable storing the symmetry that gives the canonical key, which is the lowest such symmetry if the position is symmetric itself
+<Return> :: the canonical key of the position
+*/
+unsigned long long get_canonical_key(const bitboard_position &ref_position, int &ref_symmetry)
+{
+    unsigned long long canonical_key {ref_position.symmetric_keys[0]};
+
+    ref_symmetry = 0;
+
+    for (int symmetry {1}; symmetry < 8; symmetry++)
+    {
+        if (ref_position.symmetric_keys[symmetry] < canonical_key)
+        {
+            canonical_key = ref_position.symmetric_keys[symmetry];
+            ref_symmetry = symmetry;
+        }
+    }
+
+    return canonical_key;
+}
+
+
+/*
+<Summary> :: resizes a transposition table to a fixed number of cache-line buckets and clears all its entries
+<Parameter "ref_table"> :: a reference to the transposition table
+<Parameter "total_buckets"> :: the number of buckets, which must be a power of two
+<Return> :: none
+*/
+void clear_transposition_table(transposition_table &ref_table, int total_buckets)
+{
+    // allocates new buckets instead of assigning them, since the atomic slots cannot be copied
+    ref_table.buckets = std::vector<transposition_bucket>(total_buckets);
+    ref_table.generation = 0;
+
+    return;
+}
+
+
+/*
+<Summary> :: looks up a position in a transposition table, and checks whether its stored value can replace a search with a specified depth and window
+<Parameter "ref_table"> :: a reference to the transposition table
+<Parameter "search_key"> :: the search key of the position
+<Parameter "symmetry"> :: the symmetry that transforms the moves of the position into the moves of the stored entry
+<Parameter "ply"> :: the number of stones placed since the root, which converts a stored win back to the value counted from the root
+<Parameter "search_depth"> :: the number of moves to be predicted
+<Parameter "is_exact_depth_required"> :: whether only a value searched to exactly the same depth can be returned, which keeps the result independent of the search order
+<Parameter "max_board_value"> :: the maximum board value that the AI has found
+<Parameter "min_board_value"> :: the minimum board value that the player has found
+<Parameter "ref_stored_value"> :: a reference to the variable storing the stored board value
+<Parameter "ref_best_move"> :: a reference to the variable storing the stored best move, or -1 if the position is not found
+<Return> :: whether the stored board value can be returned without searching
+*/
+bool probe_transposition_table(const transposition_table &ref_table, unsigned long long search_key, int symmetry, int ply, int search_depth, bool is_exact_depth_required, int max_board_value, int min_board_value, int &ref_stored_value, int &ref_best_move)
+{
+    const transposition_bucket &ref_bucket {ref_table.buckets[search_key & (ref_table.buckets.size() - 1)]};
+    unsigned int key_check {static_cast<unsigned int>(search_key >> 32)};
+
+    ref_best_move = -1;
+
+    for (const transposition_slot &ref_slot : ref_bucket.slots)
+    {
+        transposition_entry entry {load_transposition_entry(ref_slot)};
+
+        if (entry.bound != 0 && entry.key_check == key_check)
+        {
+            if (entry.best_move != 255)
+                ref_best_move = restore_move(entry.best_move, symmetry);
+
+            ref_stored_value = entry.value;
+
+            if (entry.value > max_assessed_value)
+                ref_stored_value -= ply;
+            else if (entry.value < -max_assessed_value)
+                ref_stored_value += ply;
+
+            if (entry.depth < search_depth || (is_exact_depth_required && entry.depth != search_depth))
+                return false;
+
+            // an exact value can always be used, while a bound can only be used if it falls outside the current window
+            if (entry.bound == 1)
+                return true;
+
+            if (entry.bound == 2 && ref_stored_value >= min_board_value)
+                return true;
+
+            if (entry.bound == 3 && ref_stored_value <= max_board_value)
+                return true;
+
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+<Summary> :: stores the search result of a position to a transposition table, replacing the least useful entry of its bucket
+<Parameter "ref_table"> :: a reference to the transposition table
+<Parameter "search_key"> :: the search key of the position
+<Parameter "symmetry"> :: the symmetry that transforms the moves of the position into the moves of the stored entry
+<Parameter "ply"> :: the number of stones placed since the root, which converts a win counted from the root to the value counted from the position
+<Parameter "search_depth"> :: the number of moves predicted by the search
+<Parameter "board_value"> :: the board value returned by the search
+<Parameter "max_board_value"> :: the maximum board value that the AI had found before the search
+<Parameter "min_board_value"> :: the minimum board value that the player had found before the search
+<Parameter "best_move"> :: the best move found by the search, or -1 if no move raises the window
+<Return> :: none
+*/
+void store_transposition_table(transposition_table &ref_table, unsigned long long search_key, int symmetry, int ply, int search_depth, int board_value, int max_board_value, int min_board_value, int best_move)
+{
+    transposition_bucket &ref_bucket {ref_table.buckets[search_key & (ref_table.buckets.size() - 1)]};
+    unsigned int key_check {static_cast<unsigned int>(search_key >> 32)};
+    transposition_entry entries[4];
+    transposition_entry new_entry;
+    int replaced_index {0};
+
+    // stores the best move in the symmetry of the canonical key, where every symmetric position finds it
+    if (best_move != -1)
+        best_move = symmetric_points[symmetry][best_move];
+
+    for (int index {0}; index < 4; index++)
+        entries[index] = load_transposition_entry(ref_bucket.slots[index]);
+
+    for (int index {0}; index < 4; index++)
+    {
+        const transposition_entry &ref_entry {entries[index]};
+        const transposition_entry &ref_replaced_entry {entries[replaced_index]};
+
+        // reuses the entry of the same position, and keeps its best move if the new search does not find one
+        if (ref_entry.bound != 0 && ref_entry.key_check == key_check)
+        {
+            if (best_move == -1 && ref_entry.best_move != 255)
+                best_move = ref_entry.best_move;
+
+            replaced_index = index;
+            break;
+        }
+
+        // prefers an empty entry, then an entry from an earlier generation, and then the shallowest entry
+        if (ref_entry.bound == 0)
+        {
+            replaced_index = index;
+        }
+        else if (ref_replaced_entry.bound != 0)
+        {
+            bool is_older {ref_entry.generation != ref_table.generation && ref_replaced_entry.generation == ref_table.generation};
+            bool is_same_generation {(ref_entry.generation == ref_table.generation) == (ref_replaced_entry.generation == ref_table.generation)};
+
+            if (is_older || (is_same_generation && ref_entry.depth < ref_replaced_entry.depth))
+                replaced_index = index;
+        }
+    }
+
+    new_entry.key_check = key_check;
+    new_entry.best_move = best_move == -1 ? 255 : best_move;
+    new_entry.depth = search_depth;
+    new_entry.generation = ref_table.generation;
+
+    // an upper bound is stored if no move raises the maximum board value, and a lower bound is stored if the minimum board value is reached
+    if (board_value <= max_board_value)
+        new_entry.bound = 3;
+    else if (board_value >= min_board_value)
+        new_entry.bound = 2;
+    else
+        new_entry.bound = 1;
+
+    // counts a win from the stored position, so that the entry gives the right distance to the win wherever the position is reached again
+    if (board_value > max_assessed_value)
+        board_value += ply;
+    else if (board_value < -max_assessed_value)
+        board_value -= ply;
+
+    new_entry.value = board_value;
+
+    save_transposition_entry(ref_bucket.slots[replaced_index], new_entry);
+
+    return;
+}
+
+
+/*
+<Summary> :: reads a transposition entry from a slot that other search threads may be writing at the same time
+<Parameter "ref_slot"> :: a reference to the slot
+<Return> :: the entry in the slot, whose key check fails if the two words of the slot come from different writes
+*/
+transposition_entry load_transposition_entry(const transposition_slot &ref_slot)
+{
+    unsigned long long value_bits {ref_slot.value_bits.load(std::memory_order_relaxed)};
+    unsigned long long packed_data {ref_slot.checked_data.load(std::memory_order_relaxed) ^ (value_bits * 0x9E3779B97F4A7C15ull)};
+    transposition_entry entry;
+
+    entry.key_check = static_cast<unsigned int>(packed_data >> 32);
+    entry.best_move = static_cast<unsigned char>(packed_data >> 24);
+    entry.depth = static_cast<signed char>(packed_data >> 16);
+    entry.bound = static_cast<unsigned char>(packed_data >> 8);
+    entry.generation = static_cast<unsigned char>(packed_data);
+    entry.value = static_cast<int>(static_cast<unsigned int>(value_bits));
+
+    return entry;
+}
+
+
+/*
+<Summary> :: writes a transposition entry to a slot without locking, by packing it into two words that verify each other
+<Parameter "ref_slot"> :: a reference to the slot
+<Parameter "ref_entry"> :: a reference to the entry to be written
+<Return> :: none
+*/
+void save_transposition_entry(transposition_slot &ref_slot, const transposition_entry &ref_entry)
+{
+    unsigned long long value_bits {static_cast<unsigned int>(ref_entry.value)};
+    unsigned long long packed_data {static_cast<unsigned long long>(ref_entry.key_check) << 32 | static_cast<unsigned long long>(ref_entry.best_move) << 24 | static_cast<unsigned long long>(static_cast<unsigned char>(ref_entry.depth)) << 16 | static_cast<unsigned long long>(ref_entry.bound) << 8 | ref_entry.generation};
+
+    // scrambles the value bits by an odd multiplier before XORing them, so that a change in any value bit reaches the key check bits
+    ref_slot.checked_data.store(packed_data ^ (value_bits * 0x9E3779B97F4A7C15ull), std::memory_order_relaxed);
+    ref_slot.value_bits.store(value_bits, std::memory_order_relaxed);
+
+    return;
+}
+
+
+/*
+<Summary> :: checks whether the player of the last move wins or the battle ends in a tie
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Return> :: whether the battle is over
+*/
+bool check_battle_state(const bitboard_position &ref_position)
+{
+    // checks whether the gomoku board is completely filled with stones if the last move does not win
+    return check_last_move_five(ref_position) || ref_position.total_stones == 225;
+}
+
+
+/*
+<Summary> :: checks whether the last move of a position forms an unbroken line of five stones, which distinguishes a win on the last empty point from a tie
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Return> :: whether the player of the last move wins
+*/
+bool check_last_move_five(const bitboard_position &ref_position)
+{
+    int row {ref_position.last_placed_row};
+    int column {ref_position.last_placed_column};
+    int side;
+
+    // no five is made if the last move is unknown, such as after a takeback of an earlier stone
+    if (row == -1)
+        return false;
+
+    side = (ref_position.row_masks[0][row] >> column) & 1 ? 0 : 1;
+
+    // checks whether the player of the last move forms an unbroken line of five stones vertically, horizontally, or diagonally
+    if (check_five_in_line(ref_position.column_masks[side][column]))
+        return true;
+
+    if (check_five_in_line(ref_position.row_masks[side][row]))
+        return true;
+
+    if (check_five_in_line(ref_position.major_diagonal_masks[side][column - row + 14]))
+        return true;
+
+    return check_five_in_line(ref_position.minor_diagonal_masks[side][row + column]);
+}
+
+
+/*
+<Summary> :: checks whether a line mask contains five or more consecutive stones
+<Parameter "line_mask"> :: the line mask of one side's stones
+<Return> :: whether the line mask contains five or more consecutive stones
+*/
+bool check_five_in_line(unsigned int line_mask)
+{
+    return (line_mask & (line_mask >> 1) & (line_mask >> 2) & (line_mask >> 3) & (line_mask >> 4)) != 0;
+}
+
+
+/*
+<Summary> :: assesses the total value of the current board state from the line values maintained by stone placement and removal
+<Parameter "ref_position"> :: a reference to the bitboard position
+<Return> :: the total value of the current board state, which is limited to the maximum assessed value
+*/
+int assess_board_value(const bitboard_position &ref_position)
+{
+    // the center weight of each stone is worth 1, and the player's stones are weighted by -5 to set the AI to focus more on defense
+    long long board_value {ref_position.total_line_value + ref_position.total_center_weights[1] - 5LL * ref_position.total_center_weights[0]};
+
+    return static_cast<int>(std::min(std::max(board_value, -static_cast<long long>(max_assessed_value)), static_cast<long long>(max_assessed_value)));
+}
+
+
+/*
+<Summary> :: assesses the value of the stones along a line by looking up the line pattern around each stone
+<Parameter "player_mask"> :: the line mask of the player's stones
+<Parameter "ai_mask"> :: the line mask of the AI's stones
+<Parameter "edge_mask"> :: the line mask of the points outside the gomoku board
+<Return> :: the sum of the pattern values of the stones in the line, where the player's stones are weighted by -5
+*/
+long long assess_line_value(unsigned int player_mask, unsigned int ai_mask, unsigned int edge_mask)
+{
+    long long player_value {0};
+    long long ai_value {0};
+
+    for (int bit {0}; player_mask >> bit; bit++)
+        if ((player_mask >> bit) & 1)
+            player_value += pattern_values[get_pattern_index(player_mask, ai_mask, edge_mask, bit)];
+
+    for (int bit {0}; ai_mask >> bit; bit++)
+        if ((ai_mask >> bit) & 1)
+            ai_value += pattern_values[get_pattern_index(ai_mask, player_mask, edge_mask, bit)];
+
+    // sets the AI to focus more on defense
+    return ai_value - player_value * 5;
+}
+
+
+/*
+<Summary> :: encodes the nine-point window around a stone along a line as the index of its line pattern
+<Parameter "own_mask"> :: the line mask of the stones owned by the same side as the specified stone
+<Parameter "opponent_mask"> :: the line mask of the opponent's stones
+<Parameter "edge_mask"> :: the line mask of the points outside the gomoku board
+<Parameter "bit"> :: the bit position of the specified stone in the line masks
+<Return> :: the index of the line pattern in the pattern values
+*/
+int get_pattern_index(unsigned int own_mask, unsigned int opponent_mask, unsigned int edge_mask, int bit)
+{
+    // shifts the masks by four bits and marks the four points before bit 0 as outside the gomoku board, so that the window starts at the stone's bit
+    // a point outside the board is encoded as both an own stone and an opponent's stone
+    unsigned int own_window {((((own_mask | edge_mask) << 4) | 0xF) >> bit) & 0x1FF};
+    unsigned int opponent_window {((((opponent_mask | edge_mask) << 4) | 0xF) >> bit) & 0x1FF};
+
+    // drops the stone itself from the middle of the windows
+    own_window = (own_window & 0xF) | ((own_window >> 5) << 4);
+    opponent_window = (opponent_window & 0xF) | ((opponent_window >> 5) << 4);
+
+    return interleaved_bits[own_window] | (interleaved_bits[opponent_window] << 1);
+}
+
+
+/*
+<Summary> :: gets the bits of a diagonal line mask that lie on the gomoku board
+<Parameter "line"> :: the index of a diagonal line, which is (column - row + 14) for major diagonals or (row + column) for minor diagonals
+<Return> :: the mask of the valid column bits of the specified diagonal line
+*/
+unsigned int get_diagonal_mask(int line)
+{
+    int first_column {line - 14 > 0 ? line - 14 : 0};
+    int last_column {line < 14 ? line : 14};
+
+    return ((1u << (last_column + 1)) - 1) & ~((1u << first_column) - 1);
+}
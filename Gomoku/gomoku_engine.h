@@ -0,0 +1,466 @@
+#ifndef GOMOKU_ENGINE_H
+#define GOMOKU_ENGINE_H
+
+#include <chrono>
+#include <thread>
+#include <random>
+#include <vector>
+#include <string>
+#include <atomic>
+
+
+/*
+<Summary> :: a bitboard representation of the Gomoku board for the AI search, which stores each side's stones as bit masks along every row, column, and diagonal
+*/
+struct bitboard_position
+{
+    // line masks indexed by [side][line], where side 0 holds the player's stones and side 1 holds the AI's stones
+    // bit n of a row mask or a diagonal mask represents column n, and bit n of a column mask represents row n
+    // major diagonals run from top left to bottom right with index (column - row + 14), and minor diagonals run from bottom left to top right with index (row + column)
+    unsigned short row_masks[2][15];
+    unsigned short column_masks[2][15];
+    unsigned short major_diagonal_masks[2][29];
+    unsigned short minor_diagonal_masks[2][29];
+    int total_stones;
+    // the last move, or -1 if there is none, which stays valid inside every search since they all place their moves with make_move, while place_stone alone only sets up a board whose move order is unknown
+    int last_placed_row;
+    int last_placed_column;
+    // the undo stack of make_move, which holds the last move before each stone placed by it as (row * 15 + column), or 255 if there was none, indexed by the number of stones before the stone
+    unsigned char undo_moves[225];
+    unsigned long long zobrist_key;
+    // the Zobrist keys of the eight rotations and reflections of the board, where the key of symmetry 0 is the Zobrist key itself
+    unsigned long long symmetric_keys[8];
+
+    // the pattern values of the stones along each line, where the values of the player's stones are weighted by -5 to set the AI to focus more on defense
+    // the values are summed in 64 bits, so that no combination of stones or tuned pattern values can overflow them
+    long long row_values[15];
+    long long column_values[15];
+    long long major_diagonal_values[29];
+    long long minor_diagonal_values[29];
+    long long total_line_value;
+
+    // the sum of distances from each side's stones to the far corners, which favors stones near the center of the gomoku board
+    int total_center_weights[2];
+
+    // the frontier holds the empty points within a square radius of any stone, which are the candidate moves of the position
+    // the neighbor count of a point is the number of stones within the radius, and the frontier index of a point is its index in the frontier list, or 255 if it is not in the frontier
+    int frontier_radius;
+    int total_frontier_moves;
+    unsigned char frontier_moves[225];
+    unsigned char frontier_indexes[225];
+    unsigned char neighbor_counts[225];
+};
+
+
+/*
+<Summary> :: a search result of a position, which is packed into a transposition slot when stored in the transposition table
+*/
+struct transposition_entry
+{
+    // the upper 32 bits of the search key, which tell apart the positions sharing a bucket
+    unsigned int key_check;
+    // the best move encoded as (row * 15 + column), or 255 if no move is known
+    unsigned char best_move;
+    // the number of moves predicted by the stored search
+    signed char depth;
+    // the meaning of the stored value (0 = empty entry, 1 = exact value, 2 = lower bound, 3 = upper bound)
+    unsigned char bound;
+    // the AI move during which the entry was stored
+    unsigned char generation;
+    // the board value, where a win is counted from the stored position instead of the root
+    int value;
+};
+
+
+/*
+<Summary> :: a transposition entry packed into two words, which search threads read and write without locking
+*/
+struct transposition_slot
+{
+    // the key check, best move, depth, bound, and generation packed from the upper bits to the lower bits, XORed with the scrambled value bits
+    // a slot torn by two threads writing at the same time fails the key check when it is read, since its words no longer match
+    std::atomic<unsigned long long> checked_data;
+    // the board value in the lower 32 bits
+    std::atomic<unsigned long long> value_bits;
+};
+
+
+/*
+<Summary> :: four transposition slots sharing one cache line, which are indexed by the lower bits of the search key
+*/
+struct alignas(64) transposition_bucket
+{
+    transposition_slot slots[4];
+};
+
+
+/*
+<Summary> :: a fixed-size hash table of search results, which recognizes the same position reached in different move orders and is shared by all search threads
+*/
+struct transposition_table
+{
+    std::vector<transposition_bucket> buckets;
+    unsigned char generation;
+};
+
+
+/*
+<Summary> :: a reply stored in the opening book file, which is read directly from the mapped file and therefore has a fixed layout of 16 bytes
+*/
+struct book_entry
+{
+    // the canonical key of the position, which is the smallest Zobrist key among the eight symmetries of the board, taken with the side to move as the AI
+    unsigned long long key;
+    // the reply in the symmetry of the canonical key, encoded as (row * 15 + column)
+    unsigned short move;
+    // the relative frequency of the reply, which grows with the games that the reply has won
+    unsigned short weight;
+    unsigned int reserved;
+};
+
+
+/*
+<Summary> :: an opening book file mapped into memory, whose entries are sorted by key and move so that the replies of a position can be found by binary search
+*/
+struct opening_book
+{
+    // the handles of the book file and its mapping on Windows, or the file descriptor elsewhere
+#ifdef _WIN32
+    void *p_file_handle;
+    void *p_mapping_handle;
+#else
+    int file_descriptor;
+#endif
+    const void *p_view;
+    long long view_size;
+    // the entries in the mapped view, or nullptr if the book is empty
+    const book_entry *p_entries;
+    long long total_entries;
+};
+
+
+/*
+<Summary> :: a node of the Monte Carlo search tree, which is stored in the arena of the tree and finds its children by index
+the search threads share the nodes without a lock, so the fields changed during a search are atomic
+*/
+struct mcts_node
+{
+    // the index of the first child in the arena, where the children of a node are stored next to each other in the order of their static scores, or -1 if the node has not been expanded, or -2 while a thread is expanding it
+    std::atomic<int> first_child;
+    // the playouts through the node, including the running playouts that have not added their results yet
+    std::atomic<int> total_visits;
+    // the results of the playouts through the node for the side that made its move, where a win counts 2 and a tie counts 1
+    std::atomic<int> total_results;
+    // the move leading to the node, encoded as (row * 15 + column), or 255 for the root
+    unsigned char move;
+    // the number of children, which is written before the first child is published
+    unsigned char total_children;
+};
+
+
+/*
+<Summary> :: the tree of the Monte Carlo tree search, which is kept between AI moves so that the subtree of the next position is searched further
+*/
+struct mcts_tree
+{
+    // the arena of the nodes, which is allocated at the first Monte Carlo tree search and filled from the front until the tree is started again
+    std::vector<mcts_node> nodes;
+    // the number of nodes that the arena holds once it is allocated
+    int total_arena_nodes;
+    // the number of nodes taken from the arena, which may pass the size of the arena while the threads race for the last nodes
+    std::atomic<int> total_used_nodes;
+    // the playouts of all threads in the current search, which are counted against the node budget
+    std::atomic<long long> total_playouts;
+    int root_index;
+    // the position of the root node, which has the AI to move
+    bitboard_position root_position;
+    // the random engine drawing the seeds of the search threads
+    std::mt19937 random_engine;
+};
+
+
+/*
+<Summary> :: the budgets that limit how long the AI searches for one move, whose default values are the settings of the game
+*/
+struct search_settings
+{
+    // the wall-clock time that the AI may spend on one move
+    int time_budget_milliseconds {1000};
+    // the maximum number of nodes searched for one move, or 0 for no limit
+    long long node_budget {0};
+    // the depth of the deepest iteration, counted in moves including the AI's next move
+    int max_search_depth {20};
+    // the square radius around the stones where the candidate moves are generated, where radius 2 finds more moves but multiplies the search nodes
+    int frontier_radius {1};
+    // the number of search threads, or 0 to use every hardware thread
+    int total_threads {0};
+    // whether the AI searches its answer to the predicted player reply while the player thinks
+    bool is_pondering_enabled {true};
+    // whether the threads split the root moves among themselves, which returns the same move for any number of threads at the same depth, instead of searching the whole tree each (Lazy SMP)
+    bool is_root_split {false};
+    // the number of fours that the continuous-four solver may make in one sequence
+    int max_vcf_depth {15};
+    // the maximum number of nodes searched by one call of the continuous-four solver
+    long long vcf_node_budget {20000};
+    // the number of stones below which the AI plays a reply from the opening book without searching
+    int max_book_stones {12};
+    // the file where the counters of every AI move are appended as one line, "-" for the standard error, or nullptr if the search is not logged
+    const char *p_search_log_path {nullptr};
+    // whether the search uses the negamax principal variation search instead of the plain alpha-beta search, which is kept for comparison
+    bool is_principal_variation_search {true};
+    // the distance from the value of the previous iteration to each end of the window that an iteration starts with, or 0 to search every iteration with the full window
+    int aspiration_window {0};
+    // whether the principal variation search reduces the late quiet moves by one move, and searches them again at the full depth only if they raise alpha, which the root split never does
+    bool is_late_move_reduction_enabled {true};
+    // the margin per remaining move by which the static board value must fall short of alpha for the quiet moves of the last two moves to be skipped, or 0 to disable futility pruning, which the root split always does
+    int futility_margin {3000};
+    // the number of moves that the principal variation search may add after the full depth, where only the fours and the blocks of fours are searched until the position is quiet, or 0 to assess the board value at the full depth
+    int max_quiescence_depth {6};
+    // whether the AI searches with the Monte Carlo tree search instead of the alpha-beta search, which needs a tree in the search context
+    bool is_monte_carlo_search {false};
+    // the number of random moves after which a playout of the Monte Carlo tree search ends as a tie
+    int max_rollout_depth {20};
+};
+
+
+/*
+<Summary> :: the counters of a search, which show where the nodes and the time of the search go
+*/
+struct search_counters
+{
+    // the nodes whose board value is assessed instead of searched, which are the nodes at the full depth and the decided nodes
+    long long leaf_evaluations;
+    long long battle_state_checks;
+    long long table_probes;
+    // the number of probes whose stored value replaced a search, which includes the positions first searched as a rotation or reflection
+    long long table_hits;
+    // the cutoffs indexed by the position of the cutoff move in the ordered moves, where the last index also counts every later position
+    long long cutoffs_by_index[8];
+    // the late moves searched at a reduced depth, the reduced moves searched again at the full depth, and the quiet moves skipped by futility pruning
+    long long reduced_moves;
+    long long reduction_researches;
+    long long futility_prunes;
+    // the nodes searched after the full depth, which only make or block fours
+    long long quiescence_nodes;
+    // the time spent generating and ordering the moves, placing and removing the stones, and assessing the leaves, which is only measured if the search is logged
+    long long move_generation_nanoseconds;
+    long long stone_update_nanoseconds;
+    long long evaluation_nanoseconds;
+};
+
+
+/*
+<Summary> :: the working state of one search, which owns a copy of the position so that the battle position stays untouched
+*/
+struct search_context
+{
+    bitboard_position position;
+    transposition_table *p_table;
+    // the opening book consulted before searching, or nullptr if the search does not use a book
+    const opening_book *p_book;
+    // the random engine picking among the replies of the opening book, which the caller seeds and never shares with a concurrent search, or nullptr to always play the heaviest reply
+    std::mt19937 *p_random_engine;
+    // the tree of the Monte Carlo tree search, or nullptr if the AI always searches with the alpha-beta search
+    mcts_tree *p_tree;
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point deadline;
+    // the signal that the main thread sets to stop the helper threads
+    const std::atomic<bool> *p_stop_signal;
+    // the signal that the caller sets to cancel the whole search, or nullptr if the search cannot be cancelled
+    const std::atomic<bool> *p_cancel_signal;
+    // the signal that the caller sets to end the search as soon as an iteration has completed, or nullptr if the search runs to its budget
+    const std::atomic<bool> *p_finish_signal;
+    // whether the search writes its counters to the search log of the settings, which is false if the caller may discard the result and logs a played result itself
+    bool is_search_logged;
+    // the number of threads splitting the root moves, or 0 if the root moves are searched by this thread alone
+    int total_split_threads;
+    bool is_principal_variation_search;
+    bool is_late_move_reduction_enabled;
+    int futility_margin;
+    int max_quiescence_depth;
+    long long node_budget;
+    long long total_nodes;
+    // the nodes searched by all threads of the search, which the node budget limits, and the nodes of this context that have been added to it
+    std::atomic<long long> *p_shared_nodes;
+    long long shared_counted_nodes;
+    int completed_depth;
+    // the best move and board value of the last completed iteration
+    int best_move;
+    int best_value;
+    bool is_aborted;
+    // the number of stones at the root, which gives the ply of a node as the number of stones placed since the root
+    int root_total_stones;
+    // the two latest moves that caused cutoffs at each ply, which often cause cutoffs in the sibling nodes as well
+    int killer_moves[225][2];
+    // the scores of the moves that caused cutoffs anywhere in the search, indexed by side and move
+    int history_scores[2][225];
+    search_counters counters;
+    // whether the time of each part of the search is measured, which costs a few reads of the clock per node
+    bool is_timed;
+    // the AI moves searched at the root, which are narrowed down to the defenses if the player has a forced win
+    int root_moves[225];
+    int total_root_moves;
+    long long vcf_nodes;
+    // the node count at which the current call of the continuous-four solver gives up, which is shared by the defense checks of the root moves and is brought forward at the deadline
+    long long vcf_node_limit;
+};
+
+
+/*
+<Summary> :: the root moves shared by the threads of a parallel root search, where each move is taken by one thread
+*/
+struct root_split
+{
+    const int *p_moves;
+    int total_moves;
+    // the index of the next move to be taken
+    std::atomic<int> next_index;
+    // the best board value found by any thread so far, which every thread uses as the lower end of its window
+    std::atomic<int> max_board_value;
+    // the board value of each move, which is exact if it reaches the best value and an upper bound otherwise
+    int move_values[225];
+};
+
+
+/*
+<Summary> :: the results of the last AI search, which are kept for monitoring the search
+*/
+struct search_report
+{
+    // the depth of the last completed iteration, which decides the AI's move
+    int completed_depth;
+    // the nodes searched by all threads, which give the node rate of the whole search
+    long long total_nodes;
+    int total_threads;
+    long long elapsed_milliseconds;
+    long long nodes_per_second;
+    // the predicted board value of the AI's move, where a stone's open direction is worth 100 and a win is worth nearly 1000000000
+    int board_value;
+    // the ratio of the cutoffs caused by the first searched move to all cutoffs
+    double first_move_cutoff_rate;
+    // whether the AI's move starts a continuous-four sequence that wins by force
+    bool is_forced_win;
+    long long vcf_nodes;
+    // whether the AI's move is taken from the opening book, in which case nothing is searched
+    bool is_book_move;
+    // the ratio of the transposition table probes whose stored value replaced a search
+    double table_hit_rate;
+    // the counters summed over all search threads
+    search_counters counters;
+    // the ratio of the playouts won through the AI's move, counting a tie as half a win, which is only measured by the Monte Carlo tree search
+    double win_rate;
+};
+
+
+/*
+<Summary> :: the proof and disproof numbers of a position stored in the proof table
+*/
+struct proof_entry
+{
+    unsigned long long key;
+    // the number of leaves that must still be proven to prove the attacking side's win, which is 0 if the win is proven
+    unsigned int proof_number;
+    // the number of leaves that must still be disproven to disprove the attacking side's win, which is 0 if the win is disproven
+    unsigned int disproof_number;
+    // the number of nodes searched below the position, or 0 for an empty entry
+    unsigned int work;
+};
+
+
+/*
+<Summary> :: the state of a proof-number search, which proves or disproves a forced win of the side to move at the root
+*/
+struct proof_search
+{
+    bitboard_position position;
+    // the node store, which is allocated once in buckets of four entries and overwritten when it is full
+    std::vector<proof_entry> entries;
+    int attacker_side;
+    long long total_nodes;
+    long long node_limit;
+    bool is_aborted;
+};
+
+
+void initialize_zobrist_keys();
+int initialize_pattern_values();
+int assess_pattern_direction(const int points[9], int first_point, int step);
+void prepare_search_context(search_context &ref_context, transposition_table *p_table, const opening_book *p_book, std::mt19937 *p_random_engine, mcts_tree *p_tree);
+void clear_search_report(search_report &ref_report);
+int search_ai_move(search_context &ref_context, const search_settings &ref_settings, search_report &ref_report);
+void deepen_search(search_context &ref_context, const search_settings &ref_settings, int first_depth, bool is_main_thread);
+void search_root_moves(search_context &ref_context, int search_depth, int max_board_value, int min_board_value, int &ref_best_move, int &ref_best_value);
+void split_root_moves(search_context &ref_context, int search_depth, const int moves[], int total_moves, int max_board_value, int &ref_best_move, int &ref_best_value);
+void search_split_moves(search_context &ref_context, root_split &ref_split, int search_depth);
+void check_search_limits(search_context &ref_context);
+long long count_shared_nodes(search_context &ref_context);
+void merge_search_counters(search_counters &ref_counters, const search_counters &ref_thread_counters, const search_counters &ref_start_counters);
+void write_search_log(const search_settings &ref_settings, const bitboard_position &ref_position, int best_move, const search_report &ref_report);
+int filter_vcf_defenses(search_context &ref_context, const search_settings &ref_settings);
+bool solve_vcf(search_context &ref_context, int side, const search_settings &ref_settings, int &ref_winning_move);
+bool search_vcf(search_context &ref_context, int side, int remaining_depth, int &ref_winning_move);
+int find_threat_points(const bitboard_position &ref_position, int side, int required_stones, int points[225]);
+unsigned int find_line_threats(unsigned int own_mask, unsigned int opponent_mask, unsigned int valid_mask, int required_stones);
+int run_proof_analysis(const char *p_board_path, const char *p_attacker, long long node_limit);
+void search_proof_numbers(proof_search &ref_search, bool is_attacker_next, unsigned int phi_threshold, unsigned int delta_threshold);
+int generate_proof_moves(proof_search &ref_search, bool is_attacker_next, int moves[225], unsigned int &ref_proof_number, unsigned int &ref_disproof_number);
+void collect_proof_sequence(proof_search &ref_search, int sequence[225], int &ref_sequence_length);
+void clear_proof_table(proof_search &ref_search, int total_entries);
+const proof_entry *find_proof_entry(const proof_search &ref_search, unsigned long long search_key);
+void store_proof_table(proof_search &ref_search, unsigned long long search_key, unsigned int proof_number, unsigned int disproof_number, long long work);
+int open_opening_book(opening_book &ref_book, const char *p_book_path);
+void close_opening_book(opening_book &ref_book);
+bool find_book_move(const opening_book &ref_book, const bitboard_position &ref_position, std::mt19937 *p_random_engine, int &ref_book_move);
+int transform_move(int move, int symmetry);
+int restore_move(int move, int symmetry);
+int run_book_builder(int argc, char *argv[], const search_settings &ref_settings);
+int play_book_game(transposition_table &ref_table, const search_settings &ref_settings, std::mt19937 &ref_random_engine, std::vector<int> &ref_moves);
+int read_book_record(const std::string &ref_record_line, std::vector<int> &ref_moves);
+void record_book_game(std::vector<book_entry> &ref_entries, const std::vector<int> &ref_moves, int max_stones, int frontier_radius);
+void set_up_game_position(bitboard_position &ref_position, const std::vector<int> &ref_moves, int total_moves, int frontier_radius);
+int save_opening_book(const char *p_book_path, std::vector<book_entry> &ref_entries);
+void clear_position(bitboard_position &ref_position, int frontier_radius);
+void place_stone(bitboard_position &ref_position, int row, int column, int stone);
+void remove_stone(bitboard_position &ref_position, int row, int column);
+void make_move(bitboard_position &ref_position, int row, int column, int stone);
+void unmake_move(bitboard_position &ref_position);
+int get_stone(const bitboard_position &ref_position, int row, int column);
+void update_line_values(bitboard_position &ref_position, int row, int column);
+void update_frontier(bitboard_position &ref_position, int row, int column, int count_change);
+void add_frontier_move(bitboard_position &ref_position, int move);
+void remove_frontier_move(bitboard_position &ref_position, int move);
+int generate_candidate_moves(const bitboard_position &ref_position, int moves[225]);
+void order_candidate_moves(search_context &ref_context, int moves[], int total_moves, int side, int best_move);
+long long score_candidate_move(const bitboard_position &ref_position, int row, int column, int side);
+void record_cutoff_move(search_context &ref_context, int move, int side, int search_depth, int move_index);
+int predict_board_value(search_context &ref_context, bool is_player_next, int search_depth, int max_board_value, int min_board_value);
+int search_principal_variation(search_context &ref_context, bool is_player_next, int search_depth, int alpha, int beta);
+int search_quiescence(search_context &ref_context, bool is_player_next, int remaining_depth, int alpha, int beta);
+bool assess_leaf_node(search_context &ref_context, bool is_player_next, int search_depth, int &ref_board_value);
+void find_tactical_points(const bitboard_position &ref_position, bool tactical_points[225]);
+void search_monte_carlo(search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, std::vector<search_context> &ref_helper_contexts, std::atomic<bool> &ref_stop_signal, double &ref_win_rate);
+void run_mcts_playouts(search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, unsigned int random_seed, bool is_main_thread);
+void run_mcts_playout(const search_context &ref_context, const search_settings &ref_settings, mcts_tree &ref_tree, std::mt19937 &ref_random_engine);
+int select_mcts_child(const mcts_tree &ref_tree, int node_index);
+bool expand_mcts_node(mcts_tree &ref_tree, int node_index, const bitboard_position &ref_position, int side, const int moves[], int total_moves);
+int play_mcts_rollout(bitboard_position &ref_position, bool is_player_next, int max_rollout_depth, std::mt19937 &ref_random_engine);
+void clear_mcts_tree(mcts_tree &ref_tree, int total_nodes);
+void reset_mcts_tree(mcts_tree &ref_tree, const bitboard_position &ref_position);
+bool reuse_mcts_tree(mcts_tree &ref_tree, const bitboard_position &ref_position);
+unsigned long long get_search_key(const bitboard_position &ref_position, bool is_player_next, int &ref_symmetry);
+unsigned long long get_canonical_key(const bitboard_position &ref_position, int &ref_symmetry);
+void clear_transposition_table(transposition_table &ref_table, int total_buckets);
+bool probe_transposition_table(const transposition_table &ref_table, unsigned long long search_key, int symmetry, int ply, int search_depth, bool is_exact_depth_required, int max_board_value, int min_board_value, int &ref_stored_value, int &ref_best_move);
+void store_transposition_table(transposition_table &ref_table, unsigned long long search_key, int symmetry, int ply, int search_depth, int board_value, int max_board_value, int min_board_value, int best_move);
+transposition_entry load_transposition_entry(const transposition_slot &ref_slot);
+void save_transposition_entry(transposition_slot &ref_slot, const transposition_entry &ref_entry);
+bool check_battle_state(const bitboard_position &ref_position);
+bool check_last_move_five(const bitboard_position &ref_position);
+bool check_five_in_line(unsigned int line_mask);
+int assess_board_value(const bitboard_position &ref_position);
+long long assess_line_value(unsigned int player_mask, unsigned int ai_mask, unsigned int edge_mask);
+int get_pattern_index(unsigned int own_mask, unsigned int opponent_mask, unsigned int edge_mask, int bit);
+unsigned int get_diagonal_mask(int line);
+
+
+#endif
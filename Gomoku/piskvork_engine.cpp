@@ -0,0 +1,447 @@
+// the headless AI engine speaks the Piskvork protocol on the standard input and output, and links only the search and evaluation engine, so that it builds without the Windows console interface
+// builds as the CMake target "pbrain-gomoku", or on Linux with "g++ -std=c++17 -O2 -pthread piskvork_engine.cpp gomoku_engine.cpp -o pbrain-gomoku"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cctype>
+
+// includes the search and evaluation engine, which is shared with the console game
+#include "gomoku_engine.h"
+
+
+bitboard_position engine_position;
+// the budgets and options of the AI, whose time budget is set from the time limits before every move
+search_settings engine_settings;
+transposition_table engine_table;
+opening_book engine_book;
+// the random engine picking among the book replies, which is seeded once when the engine starts
+std::mt19937 engine_random_engine;
+mcts_tree engine_tree;
+// the number of buckets of the transposition table, which is limited by the memory limit of the match
+int total_table_buckets {1 << 18};
+// the time limits given by the tournament manager, where 0 means no limit
+long long turn_time_limit_milliseconds {5000};
+long long match_time_left_milliseconds {0};
+
+
+int execute_protocol_command(const std::string &ref_command_line, bool &ref_is_running);
+void start_engine_game();
+int read_board_command();
+bool read_protocol_move(const std::string &ref_move_text, int &ref_row, int &ref_column);
+void update_engine_info(const std::string &ref_key, long long value);
+void play_engine_move();
+int run_protocol_test();
+
+
+int main(int argc, char *argv[])
+{
+    std::string command_line;
+    bool is_running {true};
+    int error_code;
+
+    initialize_zobrist_keys();
+    engine_random_engine.seed(std::random_device {}());
+
+    if ((error_code = initialize_pattern_values()) || (error_code = open_opening_book(engine_book, "opening_book.bin")))
+    {
+        std::cout << "ERROR the engine terminates at the line " << error_code << std::endl;
+        return -1;
+    }
+
+    // the manager waits for the replies, so the pondering of the console game is never used
+    engine_settings.is_pondering_enabled = false;
+
+    // writes the counters of every move to a log file, or to the standard error for "-", if the engine is started as "pbrain-gomoku --search-log <log file>"
+    if (argc >= 3 && std::string {argv[1]} == "--search-log")
+        engine_settings.p_search_log_path = argv[2];
+
+    // plays the scripted game of the protocol test instead of reading commands, if the engine is started as "pbrain-gomoku --protocol-test"
+    if (argc >= 2 && std::string {argv[1]} == "--protocol-test")
+    {
+        if ((error_code = run_protocol_test()))
+            std::cout << "ERROR the protocol test fails at the line " << error_code << std::endl;
+
+        close_opening_book(engine_book);
+
+        return error_code ? -1 : 0;
+    }
+
+    start_engine_game();
+
+    while (is_running && std::getline(std::cin, command_line))
+    {
+        if ((error_code = execute_protocol_command(command_line, is_running)))
+            std::cout << "ERROR the command fails at the line " << error_code << std::endl;
+    }
+
+    close_opening_book(engine_book);
+
+    return 0;
+}
+
+
+/*
+<Summary> :: executes one command of the Piskvork protocol, where the coordinates of a move are written as "x,y" with x as the column and y as the row counted from 0 at the top left
+<Parameter "ref_command_line"> :: a reference to the command line read from the manager
+<Parameter "ref_is_running"> :: a reference to the variable storing whether the engine keeps reading commands, which is cleared by the END command
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int execute_protocol_command(const std::string &ref_command_line, bool &ref_is_running)
+{
+    std::istringstream command_stream {ref_command_line};
+    std::string command;
+    std::string argument;
+    int row;
+    int column;
+
+    command_stream >> command;
+    std::transform(command.begin(), command.end(), command.begin(), [](unsigned char character) { return static_cast<char>(std::toupper(character)); });
+
+    if (command.empty())
+        return 0;
+
+    if (command == "START")
+    {
+        int board_size {0};
+
+        command_stream >> board_size;
+
+        // the board of the engine is fixed to 15 x 15
+        if (board_size != 15)
+        {
+            std::cout << "ERROR unsupported board size " << board_size << std::endl;
+            return 0;
+        }
+
+        start_engine_game();
+        std::cout << "OK" << std::endl;
+    }
+    else if (command == "RESTART")
+    {
+        start_engine_game();
+        std::cout << "OK" << std::endl;
+    }
+    else if (command == "BEGIN")
+    {
+        play_engine_move();
+    }
+    else if (command == "TURN")
+    {
+        command_stream >> argument;
+
+        if (!read_protocol_move(argument, row, column))
+        {
+            std::cout << "ERROR invalid move " << argument << std::endl;
+            return 0;
+        }
+
+        make_move(engine_position, row, column, 1);
+
+        play_engine_move();
+    }
+    else if (command == "BOARD")
+    {
+        return read_board_command();
+    }
+    else if (command == "TAKEBACK")
+    {
+        command_stream >> argument;
+
+        // a takeback removes a stone, so the move only has to be a point of the board
+        read_protocol_move(argument, row, column);
+        if (row == -1)
+        {
+            std::cout << "ERROR invalid move " << argument << std::endl;
+            return 0;
+        }
+
+        // takes back an earlier stone by unmaking the moves after it and making them again, so that the last move and the undo stack keep the order of the remaining moves
+        if (((engine_position.row_masks[0][row] | engine_position.row_masks[1][row]) >> column) & 1)
+        {
+            int later_moves[225];
+            int later_stones[225];
+            int total_later_moves {0};
+
+            while (engine_position.last_placed_row != -1 && (engine_position.last_placed_row != row || engine_position.last_placed_column != column))
+            {
+                later_moves[total_later_moves] = engine_position.last_placed_row * 15 + engine_position.last_placed_column;
+                later_stones[total_later_moves++] = get_stone(engine_position, engine_position.last_placed_row, engine_position.last_placed_column);
+                unmake_move(engine_position);
+            }
+
+            // removes the stone directly if the undo stack does not reach it, which keeps the board right even without a move order
+            if (engine_position.last_placed_row == -1)
+                remove_stone(engine_position, row, column);
+            else
+                unmake_move(engine_position);
+
+            for (int index {total_later_moves - 1}; index >= 0; index--)
+                make_move(engine_position, later_moves[index] / 15, later_moves[index] % 15, later_stones[index]);
+        }
+
+        std::cout << "OK" << std::endl;
+    }
+    else if (command == "INFO")
+    {
+        long long value {0};
+
+        command_stream >> argument >> value;
+        update_engine_info(argument, value);
+    }
+    else if (command == "ABOUT")
+    {
+        std::cout << "name=\"Gomoku\", version=\"1.0\"" << std::endl;
+    }
+    else if (command == "END")
+    {
+        ref_is_running = false;
+    }
+    else
+    {
+        std::cout << "UNKNOWN " << command << std::endl;
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: clears the board, the transposition table, and the Monte Carlo search tree for a new game
+<Parameters> :: none
+<Return> :: none
+*/
+void start_engine_game()
+{
+    clear_position(engine_position, engine_settings.frontier_radius);
+    clear_transposition_table(engine_table, total_table_buckets);
+    clear_mcts_tree(engine_tree, 1 << 20);
+
+    return;
+}
+
+
+/*
+<Summary> :: reads the lines of the BOARD command until DONE, where each line is "x,y,field" with field 1 for the engine's stone and field 2 for the opponent's stone, and then plays the engine's move
+<Parameters> :: none
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int read_board_command()
+{
+    std::string board_line;
+
+    // keeps the transposition table, since the board usually continues the game searched before
+    clear_position(engine_position, engine_settings.frontier_radius);
+
+    while (std::getline(std::cin, board_line))
+    {
+        int column;
+        int row;
+        int field;
+
+        board_line.erase(board_line.find_last_not_of(" \t\r") + 1);
+
+        if (board_line == "DONE")
+        {
+            play_engine_move();
+            return 0;
+        }
+
+        // exits the current function if a line is not a stone on an empty point
+        if (std::sscanf(board_line.c_str(), "%d,%d,%d", &column, &row, &field) != 3 || row < 0 || row >= 15 || column < 0 || column >= 15 || (field != 1 && field != 2))
+            return __LINE__;
+
+        if (((engine_position.row_masks[0][row] | engine_position.row_masks[1][row]) >> column) & 1)
+            return __LINE__;
+
+        make_move(engine_position, row, column, field == 1 ? -1 : 1);
+    }
+
+    // exits the current function if the input ends before DONE
+    return __LINE__;
+}
+
+
+/*
+<Summary> :: reads a move written as "x,y", and checks that it is on an empty point of the board
+<Parameter "ref_move_text"> :: a reference to the text of the move
+<Parameter "ref_row"> :: a reference to the variable storing the row of the move, or -1 if the text is not a point of the board
+<Parameter "ref_column"> :: a reference to the variable storing the column of the move, or -1 if the text is not a point of the board
+<Return> :: whether the move is on an empty point
+*/
+bool read_protocol_move(const std::string &ref_move_text, int &ref_row, int &ref_column)
+{
+    int row;
+    int column;
+
+    ref_row = -1;
+    ref_column = -1;
+
+    if (std::sscanf(ref_move_text.c_str(), "%d,%d", &column, &row) != 2 || row < 0 || row >= 15 || column < 0 || column >= 15)
+        return false;
+
+    ref_row = row;
+    ref_column = column;
+
+    return !(((engine_position.row_masks[0][row] | engine_position.row_masks[1][row]) >> column) & 1);
+}
+
+
+/*
+<Summary> :: applies an INFO command of the manager, which sets the time limits and the memory limit of the engine
+<Parameter "ref_key"> :: a reference to the key of the information
+<Parameter "value"> :: the value of the information, which is 0 for a key without a number
+<Return> :: none
+*/
+void update_engine_info(const std::string &ref_key, long long value)
+{
+    if (ref_key == "timeout_turn")
+    {
+        turn_time_limit_milliseconds = value;
+    }
+    else if (ref_key == "time_left")
+    {
+        match_time_left_milliseconds = value;
+    }
+    else if (ref_key == "max_memory" && value > 0)
+    {
+        // keeps the table within half of the memory limit, since the rest of the engine also takes memory
+        total_table_buckets = 1 << 10;
+        while (static_cast<long long>(total_table_buckets) * 2 * static_cast<long long>(sizeof(transposition_bucket)) <= value / 2 && total_table_buckets < (1 << 22))
+            total_table_buckets *= 2;
+
+        clear_transposition_table(engine_table, total_table_buckets);
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: searches the engine's move within the time limits of the manager, places it on the board, and writes it as "x,y"
+<Parameters> :: none
+<Return> :: none
+*/
+void play_engine_move()
+{
+    search_context *p_context {new search_context};
+    search_settings settings {engine_settings};
+    search_report report;
+    long long time_budget {turn_time_limit_milliseconds > 0 ? turn_time_limit_milliseconds : 5000};
+    int best_move;
+
+    // spends at most a tenth of the match time left, and keeps a tenth of the turn limit for the overhead of the manager
+    if (match_time_left_milliseconds > 0)
+        time_budget = std::min(time_budget, match_time_left_milliseconds / 10);
+
+    settings.time_budget_milliseconds = static_cast<int>(std::max(1LL, time_budget - time_budget / 10));
+
+    p_context->position = engine_position;
+    prepare_search_context(*p_context, &engine_table, &engine_book, &engine_random_engine, &engine_tree);
+
+    best_move = search_ai_move(*p_context, settings, report);
+
+    delete p_context;
+
+    // opens at the center of an empty board, and answers a full board with an error instead of a move
+    if (best_move == -1 && engine_position.total_stones == 0)
+    {
+        best_move = 7 * 15 + 7;
+    }
+    else if (best_move == -1)
+    {
+        std::cout << "ERROR the board has no empty point" << std::endl;
+        return;
+    }
+    else
+    {
+        std::cout << "MESSAGE depth " << report.completed_depth << " value " << report.board_value << " nodes " << report.total_nodes << " time " << report.elapsed_milliseconds << " ms" << (report.is_book_move ? " book" : "") << (report.is_forced_win ? " forced win" : "") << std::endl;
+    }
+
+    make_move(engine_position, best_move / 15, best_move % 15, -1);
+
+    std::cout << best_move % 15 << ',' << best_move / 15 << std::endl;
+
+    return;
+}
+
+
+/*
+<Summary> :: plays a scripted game through the protocol commands, where TURN is followed by TAKEBACK of the engine's move, of the opponent's last move, and of an earlier stone, and checks the board, the last move, and the undo stack after each command
+then checks that BEGIN opens at the center of an empty board, and that the engine places no stone on a full board
+<Parameters> :: none
+<Return> :: the return value would be 0 if every check passes; otherwise the return value would be the line number where the check fails
+*/
+int run_protocol_test()
+{
+    bool is_running {true};
+    int engine_move;
+    int error_code;
+
+    for (const char *p_command : {"START 15", "INFO timeout_turn 100", "TURN 7,7"})
+        if ((error_code = execute_protocol_command(p_command, is_running)))
+            return error_code;
+
+    if (engine_position.total_stones != 2 || get_stone(engine_position, engine_position.last_placed_row, engine_position.last_placed_column) != -1)
+        return __LINE__;
+
+    // taking back the engine's move leaves the opponent's stone as the last move
+    engine_move = engine_position.last_placed_row * 15 + engine_position.last_placed_column;
+    if ((error_code = execute_protocol_command("TAKEBACK " + std::to_string(engine_move % 15) + ',' + std::to_string(engine_move / 15), is_running)))
+        return error_code;
+
+    if (engine_position.total_stones != 1 || engine_position.last_placed_row != 7 || engine_position.last_placed_column != 7 || get_stone(engine_position, engine_move / 15, engine_move % 15) != 0)
+        return __LINE__;
+
+    // taking back the opponent's stone empties the board and its last move
+    if ((error_code = execute_protocol_command("TAKEBACK 7,7", is_running)))
+        return error_code;
+
+    if (engine_position.total_stones != 0 || engine_position.last_placed_row != -1 || engine_position.last_placed_column != -1)
+        return __LINE__;
+
+    if ((error_code = execute_protocol_command("TURN 8,6", is_running)))
+        return error_code;
+
+    if (engine_position.total_stones != 2 || get_stone(engine_position, 6, 8) != 1 || get_stone(engine_position, engine_position.last_placed_row, engine_position.last_placed_column) != -1)
+        return __LINE__;
+
+    // taking back a stone before the last move keeps the engine's move as the last move, with an empty undo stack below it
+    engine_move = engine_position.last_placed_row * 15 + engine_position.last_placed_column;
+    if ((error_code = execute_protocol_command("TAKEBACK 8,6", is_running)))
+        return error_code;
+
+    if (engine_position.total_stones != 1 || get_stone(engine_position, 6, 8) != 0 || engine_position.last_placed_row * 15 + engine_position.last_placed_column != engine_move || engine_position.undo_moves[0] != 255)
+        return __LINE__;
+
+    if ((error_code = execute_protocol_command("TURN 8,6", is_running)))
+        return error_code;
+
+    if (engine_position.total_stones != 3 || get_stone(engine_position, 6, 8) != 1 || get_stone(engine_position, engine_position.last_placed_row, engine_position.last_placed_column) != -1)
+        return __LINE__;
+
+    for (const char *p_command : {"RESTART", "BEGIN"})
+        if ((error_code = execute_protocol_command(p_command, is_running)))
+            return error_code;
+
+    if (engine_position.total_stones != 1 || get_stone(engine_position, 7, 7) != -1)
+        return __LINE__;
+
+    // fills the board in pairs of columns, which makes no five in any line, and asks for a move on the full board
+    if ((error_code = execute_protocol_command("RESTART", is_running)))
+        return error_code;
+
+    for (int move {0}; move < 225; move++)
+        make_move(engine_position, move / 15, move % 15, (move % 15 / 2 + move / 15) % 2 == 0 ? 1 : -1);
+
+    play_engine_move();
+
+    if (engine_position.total_stones != 225)
+        return __LINE__;
+
+    std::cout << "the protocol test passed" << std::endl;
+
+    return 0;
+}
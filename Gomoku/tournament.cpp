@@ -0,0 +1,340 @@
+// the tournament runner plays games between two AI configurations on every core, and reports their results and Elo difference, so that a change of the engine can be validated against its previous settings
+// builds as the CMake target "tournament", or on Linux with "g++ -std=c++17 -O2 -pthread tournament.cpp gomoku_engine.cpp -o tournament"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <mutex>
+#include <cmath>
+#include <cstdlib>
+
+// includes the search and evaluation engine, which is shared with the console game
+#include "gomoku_engine.h"
+
+
+/*
+<Summary> :: the result of one tournament game, which is stored by the worker thread that plays it
+*/
+struct tournament_game
+{
+    // the configuration that wins the game, or -1 for a draw
+    int winner;
+    int total_moves;
+    // the search totals of each configuration, indexed by configuration
+    long long total_nodes[2];
+    long long total_milliseconds[2];
+    int searched_moves[2];
+};
+
+
+/*
+<Summary> :: the games of a tournament and the work queue shared by the worker threads
+*/
+struct tournament_state
+{
+    search_settings settings[2];
+    int total_games;
+    unsigned int seed;
+    // the index of the next game to be played, which is taken by the first idle worker
+    std::atomic<int> next_game;
+    std::atomic<int> finished_games;
+    std::vector<tournament_game> games;
+    std::mutex output_mutex;
+};
+
+
+int read_player_config(const std::string &ref_config_text, search_settings &ref_settings);
+void run_tournament_games(tournament_state &ref_state);
+void play_tournament_game(tournament_state &ref_state, int game_index, transposition_table tables[2], mcts_tree trees[2], tournament_game &ref_game);
+void show_tournament_report(const tournament_state &ref_state);
+double convert_score_to_elo(double score);
+
+
+int main(int argc, char *argv[])
+{
+    tournament_state *p_state {new tournament_state};
+    std::vector<std::thread> worker_threads;
+    int total_workers;
+    int error_code;
+
+    // shows the usage if the program is not started as "tournament <games> <workers> <seed> <config A> <config B>"
+    if (argc < 6)
+    {
+        std::cout << "usage: tournament <games> <workers, or 0 for every core> <seed> <config A> <config B>\n";
+        std::cout << "a config is a list such as \"time=200,nodes=0,depth=20,radius=1,vcf=15,pvs=1,aspiration=0,lmr=1,futility=3000,quiescence=6,mcts=0,rollout=20\"\n";
+        delete p_state;
+        return -1;
+    }
+
+    initialize_zobrist_keys();
+
+    if ((error_code = initialize_pattern_values()) || (error_code = read_player_config(argv[4], p_state->settings[0])) || (error_code = read_player_config(argv[5], p_state->settings[1])))
+    {
+        std::cout << "[Error] The tournament terminates at the line " << error_code << "!\n";
+        delete p_state;
+        return -1;
+    }
+
+    // plays the games in pairs with the colors swapped, so that each opening is played by both configurations as the first mover
+    p_state->total_games = std::max(2, std::atoi(argv[1]) / 2 * 2);
+    p_state->seed = static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10));
+    p_state->next_game.store(0);
+    p_state->finished_games.store(0);
+    p_state->games.resize(p_state->total_games);
+
+    total_workers = std::atoi(argv[2]) > 0 ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    total_workers = std::max(1, std::min(total_workers, p_state->total_games));
+
+    for (int index {0}; index < total_workers; index++)
+        worker_threads.emplace_back(run_tournament_games, std::ref(*p_state));
+
+    for (std::thread &ref_thread : worker_threads)
+        ref_thread.join();
+
+    show_tournament_report(*p_state);
+
+    delete p_state;
+
+    return 0;
+}
+
+
+/*
+<Summary> :: reads a configuration of the AI from a comma-separated list of "key=value" items, where the keys are time, nodes, depth, radius, vcf, pvs, aspiration, lmr, futility, quiescence, mcts, and rollout, and the omitted keys keep the default AI settings
+<Parameter "ref_config_text"> :: a reference to the text of the configuration
+<Parameter "ref_settings"> :: a reference to the settings storing the configuration, which search on one thread
+<Return> :: the return value would be 0 if the function succeeds; otherwise the return value would be the line number where the error occurs
+*/
+int read_player_config(const std::string &ref_config_text, search_settings &ref_settings)
+{
+    std::istringstream config_stream {ref_config_text};
+    std::string config_item;
+
+    ref_settings = search_settings {};
+    ref_settings.total_threads = 1;
+    ref_settings.is_pondering_enabled = false;
+
+    while (std::getline(config_stream, config_item, ','))
+    {
+        std::size_t separator {config_item.find('=')};
+        std::string key;
+        long long value;
+
+        // exits the current function if an item is not a key with a number
+        if (separator == std::string::npos)
+            return __LINE__;
+
+        key = config_item.substr(0, separator);
+        value = std::atoll(config_item.c_str() + separator + 1);
+
+        if (key == "time" && value > 0)
+            ref_settings.time_budget_milliseconds = static_cast<int>(value);
+        else if (key == "nodes" && value >= 0)
+            ref_settings.node_budget = value;
+        else if (key == "depth" && value > 0)
+            ref_settings.max_search_depth = static_cast<int>(value);
+        else if (key == "radius" && (value == 1 || value == 2))
+            ref_settings.frontier_radius = static_cast<int>(value);
+        else if (key == "vcf" && value >= 0)
+            ref_settings.max_vcf_depth = static_cast<int>(value);
+        else if (key == "pvs" && (value == 0 || value == 1))
+            ref_settings.is_principal_variation_search = value == 1;
+        else if (key == "aspiration" && value >= 0)
+            ref_settings.aspiration_window = static_cast<int>(value);
+        else if (key == "lmr" && (value == 0 || value == 1))
+            ref_settings.is_late_move_reduction_enabled = value == 1;
+        else if (key == "futility" && value >= 0)
+            ref_settings.futility_margin = static_cast<int>(value);
+        else if (key == "quiescence" && value >= 0)
+            ref_settings.max_quiescence_depth = static_cast<int>(value);
+        else if (key == "mcts" && (value == 0 || value == 1))
+            ref_settings.is_monte_carlo_search = value == 1;
+        else if (key == "rollout" && value > 0)
+            ref_settings.max_rollout_depth = static_cast<int>(value);
+        else
+            return __LINE__;
+    }
+
+    return 0;
+}
+
+
+/*
+<Summary> :: takes the next game from the work queue and plays it until every game has been taken, which runs on each worker thread
+<Parameter "ref_state"> :: a reference to the tournament state
+<Return> :: none
+*/
+void run_tournament_games(tournament_state &ref_state)
+{
+    // gives each configuration its own transposition table and search tree, so that one side never reads the results of the other
+    transposition_table *p_tables {new transposition_table[2]};
+    mcts_tree *p_trees {new mcts_tree[2]};
+
+    for (int game_index {ref_state.next_game.fetch_add(1)}; game_index < ref_state.total_games; game_index = ref_state.next_game.fetch_add(1))
+    {
+        int finished_games;
+
+        play_tournament_game(ref_state, game_index, p_tables, p_trees, ref_state.games[game_index]);
+
+        // shows the progress once every 10 games
+        finished_games = ref_state.finished_games.fetch_add(1) + 1;
+        if (finished_games % 10 == 0)
+        {
+            std::lock_guard<std::mutex> output_lock {ref_state.output_mutex};
+            std::cout << "finished " << finished_games << " / " << ref_state.total_games << " games\n" << std::flush;
+        }
+    }
+
+    delete[] p_tables;
+    delete[] p_trees;
+
+    return;
+}
+
+
+/*
+<Summary> :: plays one tournament game from a seeded random opening, where the center and two random stones next to it are placed before the configurations take turns
+<Parameter "ref_state"> :: a reference to the tournament state
+<Parameter "game_index"> :: the index of the game, where the games 2n and 2n + 1 share an opening and configuration A moves first in the even game
+<Parameter "tables"> :: the transposition tables of the worker, indexed by configuration
+<Parameter "trees"> :: the Monte Carlo search trees of the worker, indexed by configuration
+<Parameter "ref_game"> :: a reference to the structure storing the result of the game
+<Return> :: none
+*/
+void play_tournament_game(tournament_state &ref_state, int game_index, transposition_table tables[2], mcts_tree trees[2], tournament_game &ref_game)
+{
+    std::mt19937 random_engine {ref_state.seed + static_cast<unsigned int>(game_index / 2)};
+    search_context *p_context {new search_context};
+    std::vector<int> moves(1, 7 * 15 + 7);
+    int first_config {game_index % 2};
+
+    ref_game.winner = -1;
+
+    for (int config {0}; config < 2; config++)
+    {
+        clear_transposition_table(tables[config], 1 << 16);
+        clear_mcts_tree(trees[config], 1 << 20);
+        ref_game.total_nodes[config] = 0;
+        ref_game.total_milliseconds[config] = 0;
+        ref_game.searched_moves[config] = 0;
+    }
+
+    while (true)
+    {
+        int config {(first_config + static_cast<int>(moves.size())) % 2};
+        int move;
+
+        // sets up the position with the side to move as the AI, which lets the same search play both configurations
+        set_up_game_position(p_context->position, moves, static_cast<int>(moves.size()), ref_state.settings[config].frontier_radius);
+
+        if (check_last_move_five(p_context->position))
+        {
+            ref_game.winner = 1 - config;
+            break;
+        }
+
+        if (p_context->position.total_stones == 225)
+            break;
+
+        if (moves.size() < 3)
+        {
+            int opening_moves[225];
+            int total_opening_moves {generate_candidate_moves(p_context->position, opening_moves)};
+
+            move = opening_moves[std::uniform_int_distribution<int> {0, total_opening_moves - 1}(random_engine)];
+        }
+        else
+        {
+            search_report report;
+
+            prepare_search_context(*p_context, &tables[config], nullptr, &random_engine, &trees[config]);
+
+            move = search_ai_move(*p_context, ref_state.settings[config], report);
+
+            ref_game.total_nodes[config] += report.total_nodes + report.vcf_nodes;
+            ref_game.total_milliseconds[config] += report.elapsed_milliseconds;
+            ref_game.searched_moves[config]++;
+        }
+
+        // ends the game in a tie if the search finds no move, which only happens on a full board
+        if (move == -1)
+            break;
+
+        moves.push_back(move);
+    }
+
+    ref_game.total_moves = static_cast<int>(moves.size());
+
+    delete p_context;
+
+    return;
+}
+
+
+/*
+<Summary> :: shows the wins, draws, and losses of configuration A against configuration B, their Elo difference with a 95% confidence interval, and the average search effort of each configuration
+<Parameter "ref_state"> :: a reference to the tournament state, whose games have all been played
+<Return> :: none
+*/
+void show_tournament_report(const tournament_state &ref_state)
+{
+    int total_results[3] {0, 0, 0};
+    long long total_nodes[2] {0, 0};
+    long long total_milliseconds[2] {0, 0};
+    long long searched_moves[2] {0, 0};
+    double score;
+    double score_variance {0.0};
+    double score_margin;
+    long long total_game_moves {0};
+
+    // counts the results as wins, draws, and losses of configuration A
+    for (const tournament_game &ref_game : ref_state.games)
+    {
+        total_results[ref_game.winner == 0 ? 0 : ref_game.winner == -1 ? 1 : 2]++;
+        total_game_moves += ref_game.total_moves;
+
+        for (int config {0}; config < 2; config++)
+        {
+            total_nodes[config] += ref_game.total_nodes[config];
+            total_milliseconds[config] += ref_game.total_milliseconds[config];
+            searched_moves[config] += ref_game.searched_moves[config];
+        }
+    }
+
+    score = (total_results[0] + 0.5 * total_results[1]) / ref_state.total_games;
+
+    // the standard error of the mean score is taken from the spread of the game results, and converted to Elo at both ends of the interval
+    score_variance += total_results[0] * (1.0 - score) * (1.0 - score);
+    score_variance += total_results[1] * (0.5 - score) * (0.5 - score);
+    score_variance += total_results[2] * score * score;
+    score_margin = 1.96 * std::sqrt(score_variance / ref_state.total_games / ref_state.total_games);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "games: " << ref_state.total_games << ", average length " << static_cast<double>(total_game_moves) / ref_state.total_games << " moves\n";
+    std::cout << "config A: " << total_results[0] << " wins, " << total_results[1] << " draws, " << total_results[2] << " losses, score " << score * 100.0 << "%\n";
+    std::cout << "Elo difference (A - B): " << convert_score_to_elo(score) << " [" << convert_score_to_elo(score - score_margin) << ", " << convert_score_to_elo(score + score_margin) << "] at 95% confidence\n";
+
+    for (int config {0}; config < 2; config++)
+    {
+        long long total_moves {std::max(1LL, searched_moves[config])};
+
+        std::cout << "config " << (config == 0 ? 'A' : 'B') << ": " << total_nodes[config] / total_moves << " nodes and " << static_cast<double>(total_milliseconds[config]) / total_moves << " ms per move\n";
+    }
+
+    return;
+}
+
+
+/*
+<Summary> :: converts the mean score of a series of games to the Elo difference that predicts it
+<Parameter "score"> :: the mean score from 0 to 1, where a win scores 1 and a draw scores 0.5
+<Return> :: the Elo difference, which is limited to a finite value for a score of 0 or 1
+*/
+double convert_score_to_elo(double score)
+{
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}